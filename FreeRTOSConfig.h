@@ -45,16 +45,54 @@
 #define configCPU_CLOCK_HZ			( ( unsigned long ) 20000000 )
 #define configTICK_RATE_HZ			( ( TickType_t ) 1000 )
 #define configMINIMAL_STACK_SIZE	( ( unsigned short ) 100)
-#define configTOTAL_HEAP_SIZE		( ( size_t ) ( 5000) )
+/* Static allocation build, "make STATIC_ALLOCATION=1": every task and queue
+lives in memory placed by standalone.ld (header.h) and there is no heap. */
+#ifndef STATIC_ALLOCATION
+#define STATIC_ALLOCATION			0
+#endif
+#if STATIC_ALLOCATION == 1
+#define configSUPPORT_STATIC_ALLOCATION		1
+#define configSUPPORT_DYNAMIC_ALLOCATION	0
+#define configTOTAL_HEAP_SIZE		( ( size_t ) 0 )
+#else
+#define configTOTAL_HEAP_SIZE		( ( size_t ) ( 4000) )
+#endif
 #define configMAX_TASK_NAME_LEN		( 10 )
 #define configUSE_TRACE_FACILITY	1
 #define configUSE_16_BIT_TICKS		0
 #define configIDLE_SHOULD_YIELD		0
+#define configUSE_MUTEXES			1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES	2 /* Index 1 is the mailbox of the N and seed values (header.h). */
 #define configGENERATE_RUN_TIME_STATS       1 
 
 
 #define configMAX_PRIORITIES		( 5 )
 
+/* Task selection through a two level bitmap, for up to 1024 priorities on any
+port.  It needs configUSE_PORT_OPTIMISED_TASK_SELECTION at 0, with the 5
+priorities used here the port's single CLZ on a 32-bit map is enough. */
+#define configUSE_BITMAP_TASK_SELECTION	0
+
+/* Delayed tasks in a timing wheel of configTIMING_WHEEL_SIZE lists instead of
+a sorted list, so blocking costs the same whatever the number of delayed
+tasks.  The wheel has a single level: a task that sleeps longer than a turn
+stays in its slot and is checked again on every turn, so a tick with tasks
+checks about n / configTIMING_WHEEL_SIZE of the n delayed tasks.  Each slot
+costs a List_t (20 bytes) plus a bit of the slot bitmap, and the task listing
+functions walk every slot: 64 slots take 1288 bytes and make the tick check a
+64th of the delayed tasks, the size should be close to the common delays.
+With a handful of tasks the sorted list is as fast and far smaller, so the
+wheel is off here. */
+#define configUSE_TIMING_WHEEL		0
+#define configTIMING_WHEEL_SIZE		64
+
+/* Most delayed tasks a single tick unblocks, 0 for no limit.  The other due
+tasks wait for the following ticks or for the idle task, so the tick
+interrupt takes bounded time however many tasks share a wake time.  With the
+timing wheel it is the most tasks a tick checks, including the tasks of later
+turns of the wheel that share the slot. */
+#define configTICK_UNBLOCK_LIMIT	0
+
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
 
@@ -67,15 +105,87 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelay				1
 #define INCLUDE_xTaskGetHandle          1 
 #define INCLUDE_uxTaskGetStackHighWaterMark 1
+#define INCLUDE_xTaskGetIdleTaskHandle  1
 
 #define configKERNEL_INTERRUPT_PRIORITY 		255
 /* !!!! configMAX_SYSCALL_INTERRUPT_PRIORITY must not be set to zero !!!!
 See http://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html. */
 #define configMAX_SYSCALL_INTERRUPT_PRIORITY 	191 /* equivalent to 0xa0, or priority 5. */
 
-extern volatile unsigned long ulHighFrequencyTimerTicks;
-#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() ( ulHighFrequencyTimerTicks = 0UL )
-#define portGET_RUN_TIME_COUNTER_VALUE()	ulHighFrequencyTimerTicks
+/* Run time statistics in core clock cycles, from a free-running counter
+extended to 64 bits (timebase.c), so no periodic interrupt is needed. */
+#include "timebase.h"
+#define configRUN_TIME_COUNTER_TYPE		uint64_t
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() vTimebaseInit()
+#define portGET_RUN_TIME_COUNTER_VALUE()	ullTimebaseGet()
+
+/* Per-task switch and blocking profile (taskprof.c).  Every task keeps its
+entry in a thread local storage pointer, set and fed by the trace macros of
+tasks.c, which is the only file that expands them.  Its table takes about
+490 bytes of RAM and its hooks run at every context switch, so it is off by
+default; set it to 1 to get the profile of every task under the Top table. */
+#define TASK_PROFILE					0
+#define TASK_PROFILE_TLS_INDEX			0
+
+/* Binary event trace recorder (recorder.c), drained with the "trace" command.
+Its ring takes 256 bytes of RAM, so it is off by default. */
+#define TRACE_RECORDER					0
+
+#if TASK_PROFILE == 1
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS	1
+extern void *pvTaskProfAlloc( void );
+extern void vTaskProfFree( void *pvProfile );
+extern void vTaskProfSwitchedOut( void *pvProfile, int xStillReady );
+extern void vTaskProfSwitchedIn( void *pvProfile );
+extern void vTaskProfReady( void *pvProfile );
+#define profileHOOK( xCall )			xCall
+#else
+#define profileHOOK( xCall )
+#endif
+
+#if TRACE_RECORDER == 1
+#include "recorder.h"
+#define recorderHOOK( xCall )			xCall
+#define recorderTASK( pxTCB )			( ( uint32_t ) ( pxTCB )->uxTCBNumber )
+#else
+#define recorderHOOK( xCall )
+#endif
+
+#if ( TASK_PROFILE == 1 ) || ( TRACE_RECORDER == 1 )
+#define traceTASK_SWITCHED_OUT()		profileHOOK( vTaskProfSwitchedOut( pxCurrentTCB->pvThreadLocalStoragePointers[ TASK_PROFILE_TLS_INDEX ], listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ), &( pxCurrentTCB->xStateListItem ) ) ) )
+#define traceTASK_SWITCHED_IN()			do { profileHOOK( vTaskProfSwitchedIn( pxCurrentTCB->pvThreadLocalStoragePointers[ TASK_PROFILE_TLS_INDEX ] ); ) recorderHOOK( vRecorderEvent( eRecorderSwitchedIn, recorderTASK( pxCurrentTCB ) ); ) } while( 0 )
+#define traceMOVED_TASK_TO_READY_STATE( pxTCB )	do { profileHOOK( vTaskProfReady( ( pxTCB )->pvThreadLocalStoragePointers[ TASK_PROFILE_TLS_INDEX ] ); ) recorderHOOK( vRecorderEvent( eRecorderTaskReady, recorderTASK( pxTCB ) ); ) } while( 0 )
+#endif
+
+#if TASK_PROFILE == 1
+#define traceTASK_CREATE( pxNewTCB )	( ( pxNewTCB )->pvThreadLocalStoragePointers[ TASK_PROFILE_TLS_INDEX ] = pvTaskProfAlloc() )
+#define traceTASK_DELETE( pxTCB )		do { vTaskProfFree( ( pxTCB )->pvThreadLocalStoragePointers[ TASK_PROFILE_TLS_INDEX ] ); ( pxTCB )->pvThreadLocalStoragePointers[ TASK_PROFILE_TLS_INDEX ] = NULL; } while( 0 )
+#endif
+
+#if TRACE_RECORDER == 1
+/* Queues and stream buffers are numbered when they are created, the numbers
+are only used to tell the objects apart in the trace. */
+#define traceQUEUE_CREATE( pxNewQueue )	( ( pxNewQueue )->uxQueueNumber = ulRecorderNewObject() )
+#define traceSTREAM_BUFFER_CREATE( pxStreamBuffer, xIsMessageBuffer )	( ( pxStreamBuffer )->uxStreamBufferNumber = ulRecorderNewObject() )
+#define traceTASK_INCREMENT_TICK( xTickCount )	vRecorderTick()
+#define traceTASK_DELAY()				vRecorderEvent( eRecorderDelay, recorderTASK( pxCurrentTCB ) )
+#define traceTASK_DELAY_UNTIL( xTimeToWake )	vRecorderEvent( eRecorderDelay, recorderTASK( pxCurrentTCB ) )
+#define traceTASK_NOTIFY_TAKE_BLOCK( uxIndexToWait )	vRecorderEvent( eRecorderNotifyTakeBlock, recorderTASK( pxCurrentTCB ) )
+#define traceTASK_NOTIFY( uxIndexToNotify )	vRecorderEvent( eRecorderNotify, recorderTASK( pxTCB ) )
+#define traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify )	vRecorderEvent( eRecorderNotifyGiveFromISR, recorderTASK( pxTCB ) )
+#define traceQUEUE_SEND( pxQueue )		vRecorderEvent( eRecorderQueueSend, ( pxQueue )->uxQueueNumber )
+#define traceQUEUE_SEND_FROM_ISR( pxQueue )	vRecorderEvent( eRecorderQueueSendFromISR, ( pxQueue )->uxQueueNumber )
+#define traceQUEUE_RECEIVE( pxQueue )	vRecorderEvent( eRecorderQueueReceive, ( pxQueue )->uxQueueNumber )
+#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )	vRecorderEvent( eRecorderQueueReceiveFromISR, ( pxQueue )->uxQueueNumber )
+#define traceBLOCKING_ON_QUEUE_SEND( pxQueue )	vRecorderEvent( eRecorderQueueBlockSend, ( pxQueue )->uxQueueNumber )
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )	vRecorderEvent( eRecorderQueueBlockReceive, ( pxQueue )->uxQueueNumber )
+#define traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesSent )	vRecorderEvent( eRecorderStreamSend, ( xStreamBuffer )->uxStreamBufferNumber )
+#define traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xBytesSent )	vRecorderEvent( eRecorderStreamSendFromISR, ( xStreamBuffer )->uxStreamBufferNumber )
+#define traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength )	vRecorderEvent( eRecorderStreamReceive, ( xStreamBuffer )->uxStreamBufferNumber )
+#define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )	vRecorderEvent( eRecorderStreamReceiveFromISR, ( xStreamBuffer )->uxStreamBufferNumber )
+#define traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer )	vRecorderEvent( eRecorderStreamBlockSend, ( xStreamBuffer )->uxStreamBufferNumber )
+#define traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer )	vRecorderEvent( eRecorderStreamBlockReceive, ( xStreamBuffer )->uxStreamBufferNumber )
+#endif
 
 
 #endif /* FREERTOS_CONFIG_H */
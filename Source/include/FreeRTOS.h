@@ -921,6 +921,50 @@
     #define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
 #endif
 
+#ifndef configUSE_BITMAP_TASK_SELECTION
+    #define configUSE_BITMAP_TASK_SELECTION    0
+#endif
+
+#if ( configUSE_BITMAP_TASK_SELECTION == 1 ) && ( configUSE_PORT_OPTIMISED_TASK_SELECTION != 0 )
+    #error configUSE_BITMAP_TASK_SELECTION replaces the port optimised task selection, set configUSE_PORT_OPTIMISED_TASK_SELECTION to 0
+#endif
+
+#if ( configUSE_BITMAP_TASK_SELECTION == 1 ) && ( configMAX_PRIORITIES > 1024 )
+    #error configUSE_BITMAP_TASK_SELECTION supports at most 1024 priorities
+#endif
+
+/* The bitmap task selection finds the highest set bit with __builtin_clz()
+ * under GCC and with a de Bruijn sequence otherwise.  Set
+ * configUSE_BITMAP_BUILTIN_CLZ to 0 to use the sequence with GCC as well, on a
+ * core without a CLZ instruction or to test it. */
+#ifndef configUSE_BITMAP_BUILTIN_CLZ
+    #if defined( __GNUC__ )
+        #define configUSE_BITMAP_BUILTIN_CLZ    1
+    #else
+        #define configUSE_BITMAP_BUILTIN_CLZ    0
+    #endif
+#endif
+
+#if ( configUSE_BITMAP_BUILTIN_CLZ == 1 ) && !defined( __GNUC__ )
+    #error configUSE_BITMAP_BUILTIN_CLZ needs GCC, set it to 0
+#endif
+
+/* The bitmap task selection keeps one bit per group of 32 priorities in a
+ * UBaseType_t.  The preprocessor cannot take its size, so its width comes
+ * from configUBASE_TYPE_WIDTH_IN_BITS, 16 by default on the ports with 16-bit
+ * ticks and 32 otherwise.  tasks.c checks the value against the real type. */
+#ifndef configUBASE_TYPE_WIDTH_IN_BITS
+    #if ( configUSE_16_BIT_TICKS == 1 )
+        #define configUBASE_TYPE_WIDTH_IN_BITS    16
+    #else
+        #define configUBASE_TYPE_WIDTH_IN_BITS    32
+    #endif
+#endif
+
+#if ( configUSE_BITMAP_TASK_SELECTION == 1 ) && ( ( ( configMAX_PRIORITIES + 31 ) / 32 ) > configUBASE_TYPE_WIDTH_IN_BITS )
+    #error configUSE_BITMAP_TASK_SELECTION needs a UBaseType_t with one bit per group of 32 priorities, lower configMAX_PRIORITIES
+#endif
+
 #ifndef configAPPLICATION_ALLOCATED_HEAP
     #define configAPPLICATION_ALLOCATED_HEAP    0
 #endif
@@ -937,6 +981,32 @@
     #error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
 #endif
 
+#ifndef configUSE_TIMING_WHEEL
+    #define configUSE_TIMING_WHEEL    0
+#endif
+
+#ifndef configTIMING_WHEEL_SIZE
+    #define configTIMING_WHEEL_SIZE    32
+#endif
+
+#if ( configUSE_TIMING_WHEEL == 1 ) && ( ( configTIMING_WHEEL_SIZE < 2 ) || ( ( configTIMING_WHEEL_SIZE & ( configTIMING_WHEEL_SIZE - 1 ) ) != 0 ) )
+    #error configTIMING_WHEEL_SIZE must be a power of two
+#endif
+
+#ifndef configTICK_UNBLOCK_LIMIT
+    #define configTICK_UNBLOCK_LIMIT    0
+#endif
+
+#ifndef configNUMBER_OF_CORES
+    #define configNUMBER_OF_CORES    1
+#endif
+
+/* tasks.c keeps a single pxCurrentTCB and its critical sections only mask
+ * interrupts on the calling core, so it can only schedule one core. */
+#if ( configNUMBER_OF_CORES != 1 )
+    #error configNUMBER_OF_CORES must be 1, this kernel has no multicore scheduler
+#endif
+
 #ifndef configUSE_POSIX_ERRNO
     #define configUSE_POSIX_ERRNO    0
 #endif
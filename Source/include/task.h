@@ -168,6 +168,15 @@ typedef struct xTASK_STATUS
     configSTACK_DEPTH_TYPE usStackHighWaterMark;  /* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } TaskStatus_t;
 
+/* Used with vTaskGetTickUnblockStats() to report how often the tick left due
+ * tasks blocked because of configTICK_UNBLOCK_LIMIT. */
+typedef struct xTICK_UNBLOCK_STATS
+{
+    uint32_t ulBacklogs;        /* The number of times a tick left due tasks in the Blocked state. */
+    uint32_t ulDeferredTicks;   /* The number of ticks that ended with due tasks still in the Blocked state. */
+    TickType_t xLongestBacklog; /* The most ticks taken to unblock all the due tasks, which bounds how late a task can leave the Blocked state. */
+} TickUnblockStats_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -1809,6 +1818,67 @@ UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray,
                                   const UBaseType_t uxArraySize,
                                   configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
 
+/**
+ * configUSE_TRACE_FACILITY must be defined as 1 in FreeRTOSConfig.h for
+ * uxTaskGetSystemStatePage() to be available.
+ *
+ * Paged version of uxTaskGetSystemState() for callers that cannot hold a
+ * TaskStatus_t structure for every task at once.  The tasks are listed in a
+ * fixed order, the Ready tasks from the highest priority down, then the
+ * Blocked, Deleted and Suspended ones, and the call returns the ones from
+ * position uxFirstTask onwards that fit in the array.  Unlike
+ * uxTaskGetSystemState(), a small array is not an error.
+ *
+ * The scheduler is only suspended while a single page is built, so a task
+ * that changes state between two calls may be returned twice or not at all.
+ *
+ * @param pxTaskStatusArray A pointer to an array of TaskStatus_t structures.
+ *
+ * @param uxArraySize The number of TaskStatus_t structures in the array.
+ *
+ * @param uxFirstTask Number of tasks to skip, 0 for the first page.
+ *
+ * @param pulTotalRunTime As in uxTaskGetSystemState(), can be NULL.
+ *
+ * @return The number of TaskStatus_t structures that were populated.  A value
+ * lower than uxArraySize means the page is the last one.
+ *
+ * Example usage:
+ * @code{c}
+ *  TaskStatus_t xPage[ 4 ];
+ *  UBaseType_t uxFirst = 0, uxCount, x;
+ *
+ *  do
+ *  {
+ *      uxCount = uxTaskGetSystemStatePage( xPage, 4, uxFirst, NULL );
+ *
+ *      for( x = 0; x < uxCount; x++ )
+ *      {
+ *          // Use xPage[ x ] here.
+ *      }
+ *
+ *      uxFirst += uxCount;
+ *  } while( uxCount == 4 );
+ *  @endcode
+ */
+UBaseType_t uxTaskGetSystemStatePage( TaskStatus_t * const pxTaskStatusArray,
+                                      const UBaseType_t uxArraySize,
+                                      const UBaseType_t uxFirstTask,
+                                      configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
+
+/**
+ * configTICK_UNBLOCK_LIMIT must be defined above 0 in FreeRTOSConfig.h for
+ * vTaskGetTickUnblockStats() to be available.
+ *
+ * With configTICK_UNBLOCK_LIMIT set, a tick unblocks at most that many
+ * delayed tasks and leaves the other due tasks to the following ticks and to
+ * the idle task.  vTaskGetTickUnblockStats() copies the counters of how often
+ * that happened since the scheduler started.
+ *
+ * @param pxStats The structure the counters are copied into.
+ */
+void vTaskGetTickUnblockStats( TickUnblockStats_t * const pxStats ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * @code{c}
@@ -115,7 +115,71 @@
     #define configIDLE_TASK_NAME    "IDLE"
 #endif
 
-#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+#if ( configUSE_BITMAP_TASK_SELECTION == 1 )
+
+/* If configUSE_BITMAP_TASK_SELECTION is 1 then task selection uses a two
+ * level bitmap that works on any port and with up to 1024 priorities.
+ * ulReadyPriorities has one bit per priority, in groups of 32, and
+ * uxTopReadyPriority has one bit per group that has a ready priority, so the
+ * highest ready priority takes two bit scans whatever configMAX_PRIORITIES
+ * is. */
+    #define taskREADY_PRIORITY_GROUPS    ( ( configMAX_PRIORITIES + 31 ) / 32 )
+
+/* Index of the highest set bit of a non-zero 32-bit word.  GCC compiles
+ * __builtin_clz() to a CLZ instruction where there is one, other compilers
+ * use a de Bruijn sequence, which takes the same time on every port.  See
+ * configUSE_BITMAP_BUILTIN_CLZ. */
+    #if ( configUSE_BITMAP_BUILTIN_CLZ == 1 )
+        #define taskBITMAP_HIGHEST_BIT( ulBits )    ( ( UBaseType_t ) ( 31U - ( uint32_t ) __builtin_clz( ( unsigned int ) ( ulBits ) ) ) )
+    #else
+        #define taskBITMAP_HIGHEST_BIT( ulBits )    prvBitmapHighestBit( ( uint32_t ) ( ulBits ) )
+    #endif
+
+    #define taskRECORD_READY_PRIORITY( uxPriority )                                           \
+    {                                                                                         \
+        ulReadyPriorities[ ( uxPriority ) >> 5U ] |= ( 1UL << ( ( uxPriority ) & 31U ) );     \
+        uxTopReadyPriority |= ( UBaseType_t ) ( 1UL << ( ( uxPriority ) >> 5U ) );            \
+    } /* taskRECORD_READY_PRIORITY */
+
+/*-----------------------------------------------------------*/
+
+    #define taskSELECT_HIGHEST_PRIORITY_TASK()                                                  \
+    {                                                                                           \
+        UBaseType_t uxTopGroup;                                                                 \
+        UBaseType_t uxTopPriority;                                                              \
+                                                                                                \
+        /* Find the highest group with a ready priority, then the highest                       \
+         * priority within it. */                                                               \
+        uxTopGroup = taskBITMAP_HIGHEST_BIT( uxTopReadyPriority );                              \
+        uxTopPriority = ( uxTopGroup << 5U ) + taskBITMAP_HIGHEST_BIT( ulReadyPriorities[ uxTopGroup ] ); \
+        configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 ); \
+        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );   \
+    } /* taskSELECT_HIGHEST_PRIORITY_TASK() */
+
+/*-----------------------------------------------------------*/
+
+/* Clears the bit of a priority whose ready list has become empty, and the bit
+ * of its group if no other priority of the group is ready.  It takes the
+ * place of the port macro of the same name. */
+    #define portRESET_READY_PRIORITY( uxPriority, uxReadyGroups )                             \
+    {                                                                                         \
+        ulReadyPriorities[ ( uxPriority ) >> 5U ] &= ~( 1UL << ( ( uxPriority ) & 31U ) );    \
+                                                                                              \
+        if( ulReadyPriorities[ ( uxPriority ) >> 5U ] == 0UL )                                \
+        {                                                                                     \
+            ( uxReadyGroups ) &= ~( ( UBaseType_t ) ( 1UL << ( ( uxPriority ) >> 5U ) ) );    \
+        }                                                                                     \
+    }
+
+    #define taskRESET_READY_PRIORITY( uxPriority )                                                     \
+    {                                                                                                  \
+        if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == ( UBaseType_t ) 0 ) \
+        {                                                                                              \
+            portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );                        \
+        }                                                                                              \
+    }
+
+#elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
  * performed in a generic way that is not optimised to any particular
@@ -192,13 +256,68 @@
         }                                                                                              \
     }
 
-#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+#endif /* configUSE_BITMAP_TASK_SELECTION */
 
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+/* The delayed tasks are kept in a hashed timing wheel: the slot of a task is
+ * its wake time modulo configTIMING_WHEEL_SIZE, so a task is placed in O(1)
+ * whatever the number of delayed tasks.  A slot is not sorted and can hold
+ * tasks that wake on later turns of the wheel.  A bitmap of the slots that may
+ * hold tasks gives a lower bound of the next wake time, which is all that
+ * xNextTaskUnblockTime needs to be.
+ *
+ * The wheel has a single level, so the tasks of later turns are checked again
+ * on every turn: with n delayed tasks the tick checks about
+ * n / configTIMING_WHEEL_SIZE tasks of a slot, not a constant number. */
+    #define taskWHEEL_MASK           ( ( TickType_t ) configTIMING_WHEEL_SIZE - ( TickType_t ) 1U )
+    #define taskWHEEL_WORDS          ( ( configTIMING_WHEEL_SIZE + 31 ) / 32 )
+    #define taskWHEEL_SLOT( xTime )    ( ( UBaseType_t ) ( ( xTime ) & taskWHEEL_MASK ) )
+
+/* Index of the lowest set bit of a non-zero 32-bit word, with a de Bruijn
+ * sequence so it takes the same time on every port. */
+    #define taskWHEEL_LOWEST_BIT( ulBits ) \
+    ( ucWheelBitIndex[ ( uint32_t ) ( ( ( ulBits ) & ( 0U - ( ulBits ) ) ) * 0x077CB531U ) >> 27U ] )
+
+/* The wake times wrap with the tick count, so the slots stay valid when it
+ * overflows and only the overflow count changes.  The tasks that wake on tick
+ * 0 are checked straight away, as the computed next unblock time never
+ * crosses an overflow. */
+    #define taskSWITCH_DELAYED_LISTS()                  \
+    {                                                   \
+        xNumOfOverflows++;                              \
+        xNextTaskUnblockTime = ( TickType_t ) 0U;       \
+    }
+
+#elif ( configTICK_UNBLOCK_LIMIT > 0 )
+
+/* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
+ * count overflows.  The delayed list may still hold due tasks left behind by
+ * the unblock limit, so it becomes the backlog list instead of being reused as
+ * the overflow list, and the backlog list, drained since the last overflow,
+ * takes its place. */
+    #define taskSWITCH_DELAYED_LISTS()                                                       \
+    {                                                                                    \
+        List_t * pxTemp;                                                                 \
+                                                                                         \
+        /* The backlog list should be empty when the lists are switched. */              \
+        configASSERT( ( listLIST_IS_EMPTY( pxBacklogDelayedTaskList ) ) );               \
+                                                                                         \
+        pxTemp = pxBacklogDelayedTaskList;                                               \
+        pxBacklogDelayedTaskList = pxDelayedTaskList;                                    \
+        pxDelayedTaskList = pxOverflowDelayedTaskList;                                   \
+        pxOverflowDelayedTaskList = pxTemp;                                              \
+        xNumOfOverflows++;                                                               \
+        prvResetNextTaskUnblockTime();                                                   \
+    }
+
+#else /* configUSE_TIMING_WHEEL */
+
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
  * count overflows. */
-#define taskSWITCH_DELAYED_LISTS()                                                \
+    #define taskSWITCH_DELAYED_LISTS()                                                \
     {                                                                             \
         List_t * pxTemp;                                                          \
                                                                                   \
@@ -212,6 +331,16 @@
         prvResetNextTaskUnblockTime();                                            \
     }
 
+#endif /* configUSE_TIMING_WHEEL */
+
+/* Most delayed tasks a single pass of the tick may unblock.  Without a limit
+ * the budget is never used up. */
+#if ( configTICK_UNBLOCK_LIMIT > 0 )
+    #define taskTICK_UNBLOCK_BUDGET    ( ( UBaseType_t ) configTICK_UNBLOCK_LIMIT )
+#else
+    #define taskTICK_UNBLOCK_BUDGET    ( ~( UBaseType_t ) 0U )
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -333,10 +462,39 @@ portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
  * doing so breaks some kernel aware debuggers and debuggers that rely on removing
  * the static qualifier. */
 PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ]; /*< Prioritised ready tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList1;                         /*< Delayed tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList2;                         /*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;      /*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#if ( configUSE_BITMAP_TASK_SELECTION == 1 )
+    PRIVILEGED_DATA static uint32_t ulReadyPriorities[ taskREADY_PRIORITY_GROUPS ]; /*< One bit per priority, set while its ready list is not empty. */
+
+/* Fails to compile if configUBASE_TYPE_WIDTH_IN_BITS is wider than
+ * UBaseType_t, the groups would not all fit in uxTopReadyPriority. */
+    typedef char taskBITMAP_GROUPS_FIT[ ( configUBASE_TYPE_WIDTH_IN_BITS <= ( sizeof( UBaseType_t ) * 8 ) ) ? 1 : -1 ];
+
+    #if ( configUSE_BITMAP_BUILTIN_CLZ == 0 )
+        static const uint8_t ucBitmapBitIndex[ 32 ] =
+        {
+            0, 9, 1, 10, 13, 21, 2, 29, 11, 14, 16, 18, 22, 25, 3, 30,
+            8, 12, 20, 28, 15, 17, 24, 7, 19, 27, 23, 6, 26, 5, 4, 31
+        };
+    #endif
+#endif
+#if ( configUSE_TIMING_WHEEL == 1 )
+    PRIVILEGED_DATA static List_t xDelayedWheel[ configTIMING_WHEEL_SIZE ];  /*< Delayed tasks, in the slot of their wake time. */
+    PRIVILEGED_DATA static uint32_t ulDelayedWheelUsed[ taskWHEEL_WORDS ];   /*< One bit per slot, set when a task is placed in the slot and cleared when the slot is found empty. */
+    static const uint8_t ucWheelBitIndex[ 32 ] =
+    {
+        0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+        31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+    };
+#else
+    PRIVILEGED_DATA static List_t xDelayedTaskList1;                         /*< Delayed tasks. */
+    PRIVILEGED_DATA static List_t xDelayedTaskList2;                         /*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+    PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /*< Points to the delayed task list currently being used. */
+    PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;      /*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+    #if ( configTICK_UNBLOCK_LIMIT > 0 )
+        PRIVILEGED_DATA static List_t xDelayedTaskList3;                     /*< Delayed tasks (a third list holds the due tasks left in the delayed list when the tick count overflowed). */
+        PRIVILEGED_DATA static List_t * volatile pxBacklogDelayedTaskList;   /*< Points to the delayed task list holding tasks that were due before the last overflow of the tick count. */
+    #endif
+#endif
 PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -394,6 +552,22 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t
 
 #endif
 
+#if ( configTICK_UNBLOCK_LIMIT > 0 )
+
+/* Due tasks the tick left blocked once it reached configTICK_UNBLOCK_LIMIT.
+ * They are unblocked by the following ticks, and by the idle task when it
+ * runs first. */
+    PRIVILEGED_DATA static volatile BaseType_t xTickBacklog = pdFALSE; /*< pdTRUE while there are due tasks still in the Blocked state. */
+    PRIVILEGED_DATA static TickType_t xTickBacklogStart = ( TickType_t ) 0U; /*< Tick at which the current backlog started. */
+    PRIVILEGED_DATA static TickUnblockStats_t xTickUnblockStats = { 0 };
+
+    #if ( configUSE_TIMING_WHEEL == 1 )
+        PRIVILEGED_DATA static TickType_t xWheelBacklogTime = ( TickType_t ) 0U; /*< First tick whose slot may still hold due tasks. */
+        PRIVILEGED_DATA static UBaseType_t uxWheelBacklogLeft = 0U;              /*< Tasks of that slot the budget left unchecked, 0 to check the whole slot. */
+    #endif
+
+#endif
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -471,6 +645,17 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                                                      List_t * pxList,
                                                      eTaskState eState ) PRIVILEGED_FUNCTION;
 
+/*
+ * Same as prvListTasksWithinSingleList(), but skips the first *puxSkip tasks
+ * and fills at most uxArraySize structures.  *puxSkip is decremented by the
+ * number of tasks skipped.  The list itself is not modified.
+ */
+    static UBaseType_t prvListTasksPageWithinSingleList( TaskStatus_t * pxTaskStatusArray,
+                                                         UBaseType_t uxArraySize,
+                                                         UBaseType_t * puxSkip,
+                                                         const List_t * pxList,
+                                                         eTaskState eState ) PRIVILEGED_FUNCTION;
+
 #endif
 
 /*
@@ -516,6 +701,61 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+/*
+ * Places the calling task in the slot of the timing wheel of its wake time,
+ * in constant time.
+ */
+    static void prvInsertDelayedTask( TickType_t xTimeToWake,
+                                      TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks the tasks of the slot of xTime whose wake time is xTime, taking one
+ * from *puxBudget for each task of the slot it checks, and sets
+ * *pxSwitchRequired if one of them should preempt the running task.  Returns
+ * pdFALSE if the budget ran out before the whole slot was checked.
+ */
+    static BaseType_t prvUnblockWheelSlot( TickType_t xTime,
+                                           UBaseType_t * const puxBudget,
+                                           BaseType_t * const pxSwitchRequired ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_BITMAP_TASK_SELECTION == 1 ) && ( configUSE_BITMAP_BUILTIN_CLZ == 0 )
+
+/*
+ * Returns the index of the highest set bit of a non-zero word, for compilers
+ * without __builtin_clz() or when configUSE_BITMAP_BUILTIN_CLZ is 0.
+ */
+    static UBaseType_t prvBitmapHighestBit( uint32_t ulBits ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Moves a delayed task whose wake time has arrived to its ready list, and
+ * returns pdTRUE if it should preempt the running task.
+ */
+static BaseType_t prvUnblockDelayedTask( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks the delayed tasks whose wake time is xConstTickCount or earlier,
+ * at most configTICK_UNBLOCK_LIMIT of them when it is set, and returns pdTRUE
+ * if one of them should preempt the running task.  Called from
+ * xTaskIncrementTick(), and from the idle task to clear a backlog.
+ */
+static BaseType_t prvUnblockDelayedTasks( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+#if ( configTICK_UNBLOCK_LIMIT > 0 )
+
+/*
+ * Records whether a pass of prvUnblockDelayedTasks() left due tasks blocked,
+ * and updates the backlog statistics.
+ */
+    static void prvRecordTickBacklog( const BaseType_t xBacklogLeft ) PRIVILEGED_FUNCTION;
+
+#endif
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
 /*
@@ -1347,8 +1587,15 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     {
         eTaskState eReturn;
         List_t const * pxStateList;
-        List_t const * pxDelayedList;
-        List_t const * pxOverflowedDelayedList;
+
+        #if ( configUSE_TIMING_WHEEL == 0 )
+            List_t const * pxDelayedList;
+            List_t const * pxOverflowedDelayedList;
+
+            #if ( configTICK_UNBLOCK_LIMIT > 0 )
+                List_t const * pxBacklogDelayedList;
+            #endif
+        #endif
         const TCB_t * const pxTCB = xTask;
 
         configASSERT( pxTCB );
@@ -1363,12 +1610,24 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             taskENTER_CRITICAL();
             {
                 pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
-                pxDelayedList = pxDelayedTaskList;
-                pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+                #if ( configUSE_TIMING_WHEEL == 0 )
+                    pxDelayedList = pxDelayedTaskList;
+                    pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+
+                    #if ( configTICK_UNBLOCK_LIMIT > 0 )
+                        pxBacklogDelayedList = pxBacklogDelayedTaskList;
+                    #endif
+                #endif
             }
             taskEXIT_CRITICAL();
 
-            if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+            #if ( configUSE_TIMING_WHEEL == 1 )
+                if( ( pxStateList >= &( xDelayedWheel[ 0 ] ) ) && ( pxStateList <= &( xDelayedWheel[ taskWHEEL_MASK ] ) ) )
+            #elif ( configTICK_UNBLOCK_LIMIT > 0 )
+                if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) || ( pxStateList == pxBacklogDelayedList ) )
+            #else
+                if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+            #endif
             {
                 /* The task being queried is referenced from one of the Blocked
                  * lists. */
@@ -2119,7 +2378,16 @@ void vTaskSuspendAll( void )
          * configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
          * task that are in the Ready state, even though the idle task is
          * running. */
-        #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+        #if ( configUSE_BITMAP_TASK_SELECTION == 1 )
+        {
+            /* uxTopReadyPriority has a bit per group of 32 priorities, the
+             * idle priority is the lowest bit of the first group. */
+            if( ( uxTopReadyPriority > ( UBaseType_t ) 1U ) || ( ulReadyPriorities[ 0 ] > 1UL ) )
+            {
+                uxHigherPriorityReadyTasks = pdTRUE;
+            }
+        }
+        #elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
         {
             if( uxTopReadyPriority > tskIDLE_PRIORITY )
             {
@@ -2140,12 +2408,21 @@ void vTaskSuspendAll( void )
                 uxHigherPriorityReadyTasks = pdTRUE;
             }
         }
-        #endif /* if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) */
+        #endif /* if ( configUSE_BITMAP_TASK_SELECTION == 1 ) */
 
         if( pxCurrentTCB->uxPriority > tskIDLE_PRIORITY )
         {
             xReturn = 0;
         }
+
+        #if ( configTICK_UNBLOCK_LIMIT > 0 )
+            else if( xTickBacklog != pdFALSE )
+            {
+                /* Due tasks are still blocked, and xNextTaskUnblockTime may
+                 * be in the past. */
+                xReturn = 0;
+            }
+        #endif
         else if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > 1 )
         {
             /* There are other idle priority tasks in the ready state.  If
@@ -2446,15 +2723,35 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
             } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
             /* Search the delayed lists. */
-            if( pxTCB == NULL )
+            #if ( configUSE_TIMING_WHEEL == 1 )
             {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+                for( uxQueue = 0; ( uxQueue < ( UBaseType_t ) configTIMING_WHEEL_SIZE ) && ( pxTCB == NULL ); uxQueue++ )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( &( xDelayedWheel[ uxQueue ] ), pcNameToQuery );
+                }
             }
-
-            if( pxTCB == NULL )
+            #else
             {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+                if( pxTCB == NULL )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+                }
+
+                if( pxTCB == NULL )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+                }
+
+                #if ( configTICK_UNBLOCK_LIMIT > 0 )
+                {
+                    if( pxTCB == NULL )
+                    {
+                        pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxBacklogDelayedTaskList, pcNameToQuery );
+                    }
+                }
+                #endif
             }
+            #endif /* configUSE_TIMING_WHEEL */
 
             #if ( INCLUDE_vTaskSuspend == 1 )
             {
@@ -2507,8 +2804,25 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
 
                 /* Fill in an TaskStatus_t structure with information on each
                  * task in the Blocked state. */
-                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
-                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+                #if ( configUSE_TIMING_WHEEL == 1 )
+                {
+                    for( uxQueue = 0; uxQueue < ( UBaseType_t ) configTIMING_WHEEL_SIZE; uxQueue++ )
+                    {
+                        uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayedWheel[ uxQueue ] ), eBlocked );
+                    }
+                }
+                #else
+                {
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+
+                    #if ( configTICK_UNBLOCK_LIMIT > 0 )
+                    {
+                        uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxBacklogDelayedTaskList, eBlocked );
+                    }
+                    #endif
+                }
+                #endif /* configUSE_TIMING_WHEEL */
 
                 #if ( INCLUDE_vTaskDelete == 1 )
                 {
@@ -2559,6 +2873,81 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
 #endif /* configUSE_TRACE_FACILITY */
 /*----------------------------------------------------------*/
 
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxTaskGetSystemStatePage( TaskStatus_t * const pxTaskStatusArray,
+                                          const UBaseType_t uxArraySize,
+                                          const UBaseType_t uxFirstTask,
+                                          configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
+    {
+        UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
+        UBaseType_t uxSkip = uxFirstTask;
+
+        vTaskSuspendAll();
+        {
+            /* Walk the lists in the same order as uxTaskGetSystemState(),
+             * each one from its head rather than from its index, so
+             * consecutive pages return consecutive parts of the same sequence
+             * while no task changes state in between. */
+            do
+            {
+                uxQueue--;
+                uxTask += prvListTasksPageWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), uxArraySize - uxTask, &uxSkip, &( pxReadyTasksLists[ uxQueue ] ), eReady );
+            } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+            #if ( configUSE_TIMING_WHEEL == 1 )
+            {
+                for( uxQueue = 0; uxQueue < ( UBaseType_t ) configTIMING_WHEEL_SIZE; uxQueue++ )
+                {
+                    uxTask += prvListTasksPageWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), uxArraySize - uxTask, &uxSkip, &( xDelayedWheel[ uxQueue ] ), eBlocked );
+                }
+            }
+            #else
+            {
+                uxTask += prvListTasksPageWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), uxArraySize - uxTask, &uxSkip, pxDelayedTaskList, eBlocked );
+                uxTask += prvListTasksPageWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), uxArraySize - uxTask, &uxSkip, pxOverflowDelayedTaskList, eBlocked );
+
+                #if ( configTICK_UNBLOCK_LIMIT > 0 )
+                {
+                    uxTask += prvListTasksPageWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), uxArraySize - uxTask, &uxSkip, pxBacklogDelayedTaskList, eBlocked );
+                }
+                #endif
+            }
+            #endif /* configUSE_TIMING_WHEEL */
+
+            #if ( INCLUDE_vTaskDelete == 1 )
+            {
+                uxTask += prvListTasksPageWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), uxArraySize - uxTask, &uxSkip, &xTasksWaitingTermination, eDeleted );
+            }
+            #endif
+
+            #if ( INCLUDE_vTaskSuspend == 1 )
+            {
+                uxTask += prvListTasksPageWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), uxArraySize - uxTask, &uxSkip, &xSuspendedTaskList, eSuspended );
+            }
+            #endif
+
+            if( pulTotalRunTime != NULL )
+            {
+                #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                    #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                        portALT_GET_RUN_TIME_COUNTER_VALUE( ( *pulTotalRunTime ) );
+                    #else
+                        *pulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+                    #endif
+                #else
+                    *pulTotalRunTime = 0;
+                #endif
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return uxTask;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*----------------------------------------------------------*/
+
 #if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
 
     TaskHandle_t xTaskGetIdleTaskHandle( void )
@@ -2719,8 +3108,6 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
 
 BaseType_t xTaskIncrementTick( void )
 {
-    TCB_t * pxTCB;
-    TickType_t xItemValue;
     BaseType_t xSwitchRequired = pdFALSE;
 
     /* Called by the portable layer each time a tick interrupt occurs.
@@ -2747,90 +3134,28 @@ BaseType_t xTaskIncrementTick( void )
             mtCOVERAGE_TEST_MARKER();
         }
 
-        /* See if this tick has made a timeout expire.  Tasks are stored in
-         * the  queue in the order of their wake time - meaning once one task
-         * has been found whose block time has not expired there is no need to
-         * look any further down the list. */
-        if( xConstTickCount >= xNextTaskUnblockTime )
+        /* See if this tick has made a timeout expire, or if an earlier tick
+         * left due tasks in the Blocked state. */
+        #if ( configTICK_UNBLOCK_LIMIT > 0 )
+            if( ( xConstTickCount >= xNextTaskUnblockTime ) || ( xTickBacklog != pdFALSE ) )
+        #else
+            if( xConstTickCount >= xNextTaskUnblockTime )
+        #endif
         {
-            for( ; ; )
+            xSwitchRequired = prvUnblockDelayedTasks( xConstTickCount );
+
+            #if ( configTICK_UNBLOCK_LIMIT > 0 )
             {
-                if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+                if( xTickBacklog != pdFALSE )
                 {
-                    /* The delayed list is empty.  Set xNextTaskUnblockTime
-                     * to the maximum possible value so it is extremely
-                     * unlikely that the
-                     * if( xTickCount >= xNextTaskUnblockTime ) test will pass
-                     * next time through. */
-                    xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                    break;
+                    xTickUnblockStats.ulDeferredTicks++;
                 }
                 else
                 {
-                    /* The delayed list is not empty, get the value of the
-                     * item at the head of the delayed list.  This is the time
-                     * at which the task at the head of the delayed list must
-                     * be removed from the Blocked state. */
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                    xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
-
-                    if( xConstTickCount < xItemValue )
-                    {
-                        /* It is not time to unblock this item yet, but the
-                         * item value is the time at which the task at the head
-                         * of the blocked list must be removed from the Blocked
-                         * state -  so record the item value in
-                         * xNextTaskUnblockTime. */
-                        xNextTaskUnblockTime = xItemValue;
-                        break; /*lint !e9011 Code structure here is deemed easier to understand with multiple breaks. */
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* It is time to remove the item from the Blocked state. */
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-
-                    /* Is the task waiting on an event also?  If so remove
-                     * it from the event list. */
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-                    {
-                        listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* Place the unblocked task into the appropriate ready
-                     * list. */
-                    prvAddTaskToReadyList( pxTCB );
-
-                    /* A task being unblocked cannot cause an immediate
-                     * context switch if preemption is turned off. */
-                    #if ( configUSE_PREEMPTION == 1 )
-                    {
-                        /* Preemption is on, but a context switch should
-                         * only be performed if the unblocked task's
-                         * priority is higher than the currently executing
-                         * task.
-                         * The case of equal priority tasks sharing
-                         * processing time (which happens when both
-                         * preemption and time slicing are on) is
-                         * handled below.*/
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-                        {
-                            xSwitchRequired = pdTRUE;
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                    }
-                    #endif /* configUSE_PREEMPTION */
+                    mtCOVERAGE_TEST_MARKER();
                 }
             }
+            #endif
         }
 
         /* Tasks of equal priority to the currently running task will share
@@ -3443,6 +3768,37 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
          * is responsible for freeing the deleted task's TCB and stack. */
         prvCheckTasksWaitingTermination();
 
+        #if ( configTICK_UNBLOCK_LIMIT > 0 )
+        {
+            BaseType_t xYieldRequired = pdFALSE;
+
+            /* Unblock the due tasks the tick left behind, a batch of at most
+             * configTICK_UNBLOCK_LIMIT per critical section, instead of
+             * leaving them to the following ticks.  Interrupts are then
+             * masked no longer than by the tick interrupt itself. */
+            if( xTickBacklog != pdFALSE )
+            {
+                taskENTER_CRITICAL();
+                {
+                    if( xTickBacklog != pdFALSE )
+                    {
+                        xYieldRequired = prvUnblockDelayedTasks( xTickCount );
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                if( xYieldRequired != pdFALSE )
+                {
+                    taskYIELD();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configTICK_UNBLOCK_LIMIT */
+
         #if ( configUSE_PREEMPTION == 0 )
         {
             /* If we are not using preemption we keep forcing a task switch to
@@ -3654,6 +4010,24 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 #endif /* portUSING_MPU_WRAPPERS */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_BITMAP_TASK_SELECTION == 1 ) && ( configUSE_BITMAP_BUILTIN_CLZ == 0 )
+
+    static UBaseType_t prvBitmapHighestBit( uint32_t ulBits )
+    {
+        /* Set every bit below the highest one, which leaves 2^n - 1 for
+         * the de Bruijn multiplication to map to n - 1. */
+        ulBits |= ulBits >> 1U;
+        ulBits |= ulBits >> 2U;
+        ulBits |= ulBits >> 4U;
+        ulBits |= ulBits >> 8U;
+        ulBits |= ulBits >> 16U;
+
+        return ( UBaseType_t ) ucBitmapBitIndex[ ( uint32_t ) ( ulBits * 0x07C4ACDDUL ) >> 27U ];
+    }
+
+#endif /* configUSE_BITMAP_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
 static void prvInitialiseTaskLists( void )
 {
     UBaseType_t uxPriority;
@@ -3663,8 +4037,26 @@ static void prvInitialiseTaskLists( void )
         vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
     }
 
-    vListInitialise( &xDelayedTaskList1 );
-    vListInitialise( &xDelayedTaskList2 );
+    #if ( configUSE_TIMING_WHEEL == 1 )
+    {
+        for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configTIMING_WHEEL_SIZE; uxPriority++ )
+        {
+            vListInitialise( &( xDelayedWheel[ uxPriority ] ) );
+        }
+    }
+    #else
+    {
+        vListInitialise( &xDelayedTaskList1 );
+        vListInitialise( &xDelayedTaskList2 );
+
+        #if ( configTICK_UNBLOCK_LIMIT > 0 )
+        {
+            vListInitialise( &xDelayedTaskList3 );
+        }
+        #endif
+    }
+    #endif /* configUSE_TIMING_WHEEL */
+
     vListInitialise( &xPendingReadyList );
 
     #if ( INCLUDE_vTaskDelete == 1 )
@@ -3679,12 +4071,22 @@ static void prvInitialiseTaskLists( void )
     }
     #endif /* INCLUDE_vTaskSuspend */
 
-    /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-     * using list2. */
-    pxDelayedTaskList = &xDelayedTaskList1;
-    pxOverflowDelayedTaskList = &xDelayedTaskList2;
-}
-/*-----------------------------------------------------------*/
+    #if ( configUSE_TIMING_WHEEL == 0 )
+    {
+        /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
+         * using list2. */
+        pxDelayedTaskList = &xDelayedTaskList1;
+        pxOverflowDelayedTaskList = &xDelayedTaskList2;
+
+        #if ( configTICK_UNBLOCK_LIMIT > 0 )
+        {
+            pxBacklogDelayedTaskList = &xDelayedTaskList3;
+        }
+        #endif
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
 
 static void prvCheckTasksWaitingTermination( void )
 {
@@ -3853,6 +4255,47 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    static UBaseType_t prvListTasksPageWithinSingleList( TaskStatus_t * pxTaskStatusArray,
+                                                         UBaseType_t uxArraySize,
+                                                         UBaseType_t * puxSkip,
+                                                         const List_t * pxList,
+                                                         eTaskState eState )
+    {
+        const ListItem_t * pxItem;
+        const ListItem_t * const pxEnd = listGET_END_MARKER( pxList );
+        UBaseType_t uxTask = 0;
+
+        /* The whole list is skipped without walking it when possible. */
+        if( *puxSkip >= listCURRENT_LIST_LENGTH( pxList ) )
+        {
+            *puxSkip -= listCURRENT_LIST_LENGTH( pxList );
+        }
+        else
+        {
+            /* Follow the links instead of listGET_OWNER_OF_NEXT_ENTRY() so
+             * the index of the list is left alone. */
+            for( pxItem = listGET_HEAD_ENTRY( pxList ); ( pxItem != pxEnd ) && ( uxTask < uxArraySize ); pxItem = listGET_NEXT( pxItem ) )
+            {
+                if( *puxSkip > ( UBaseType_t ) 0 )
+                {
+                    ( *puxSkip )--;
+                }
+                else
+                {
+                    vTaskGetInfo( ( TaskHandle_t ) listGET_LIST_ITEM_OWNER( pxItem ), &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
+                    uxTask++;
+                }
+            }
+        }
+
+        return uxTask;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
 
     static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
@@ -3996,6 +4439,219 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+static void prvResetNextTaskUnblockTime( void )
+{
+    /* The tasks that wake on the current tick have already been unblocked. */
+    const TickType_t xFrom = xTickCount + ( TickType_t ) 1;
+    const UBaseType_t uxFromSlot = taskWHEEL_SLOT( xFrom );
+    UBaseType_t uxWord = uxFromSlot / 32U;
+    uint32_t ulBits = ulDelayedWheelUsed[ uxWord ] & ( 0xFFFFFFFFUL << ( uxFromSlot % 32U ) );
+    UBaseType_t x;
+    TickType_t xNext;
+
+    /* Find the first slot in use from xFrom onwards, going round the wheel
+     * once.  The last word checked is the first one again, whole, for the
+     * slots behind xFrom. */
+    for( x = 0; ( ulBits == 0U ) && ( x < ( UBaseType_t ) taskWHEEL_WORDS ); x++ )
+    {
+        uxWord = ( uxWord + 1U ) % ( UBaseType_t ) taskWHEEL_WORDS;
+        ulBits = ulDelayedWheelUsed[ uxWord ];
+    }
+
+    if( ulBits == 0U )
+    {
+        /* The wheel is empty. */
+        xNextTaskUnblockTime = portMAX_DELAY;
+    }
+    else
+    {
+        /* No task can wake before the first slot in use, although the tasks
+         * in it may only wake on a later turn of the wheel.  A time past the
+         * overflow of the tick count is left to taskSWITCH_DELAYED_LISTS(). */
+        xNext = xFrom + ( ( ( TickType_t ) ( uxWord * 32U + taskWHEEL_LOWEST_BIT( ulBits ) ) - ( TickType_t ) uxFromSlot ) & taskWHEEL_MASK );
+
+        if( xNext < xFrom )
+        {
+            xNextTaskUnblockTime = portMAX_DELAY;
+        }
+        else
+        {
+            xNextTaskUnblockTime = xNext;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertDelayedTask( TickType_t xTimeToWake,
+                                  TickType_t xConstTickCount )
+{
+    const UBaseType_t uxSlot = taskWHEEL_SLOT( xTimeToWake );
+
+    /* The list item value is already the wake time, the slot is not sorted. */
+    listINSERT_END( &( xDelayedWheel[ uxSlot ] ), &( pxCurrentTCB->xStateListItem ) );
+    ulDelayedWheelUsed[ uxSlot / 32U ] |= ( 1UL << ( uxSlot % 32U ) );
+
+    /* A wake time past the overflow of the tick count is left to
+     * taskSWITCH_DELAYED_LISTS(), as with the overflow delayed list. */
+    if( ( xTimeToWake >= xConstTickCount ) && ( xTimeToWake < xNextTaskUnblockTime ) )
+    {
+        xNextTaskUnblockTime = xTimeToWake;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockWheelSlot( TickType_t xTime,
+                                       UBaseType_t * const puxBudget,
+                                       BaseType_t * const pxSwitchRequired )
+{
+    const UBaseType_t uxSlot = taskWHEEL_SLOT( xTime );
+    List_t * const pxSlot = &( xDelayedWheel[ uxSlot ] );
+    ListItem_t * pxItem;
+    UBaseType_t uxLeft = listCURRENT_LIST_LENGTH( pxSlot );
+    BaseType_t xComplete = pdTRUE;
+
+    #if ( configTICK_UNBLOCK_LIMIT > 0 )
+    {
+        /* Resume the pass the budget stopped.  Only the tasks it did not
+         * check are still at the head of the slot. */
+        if( uxWheelBacklogLeft != 0U )
+        {
+            configASSERT( xTime == xWheelBacklogTime );
+            uxLeft = uxWheelBacklogLeft;
+            uxWheelBacklogLeft = 0U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configTICK_UNBLOCK_LIMIT */
+
+    /* Every task checked is paid from the budget, whether it wakes now or on a
+     * later turn of the wheel, so a pass stops after a fixed number of tasks
+     * however full the slot is. */
+    while( ( uxLeft > 0U ) && ( listLIST_IS_EMPTY( pxSlot ) == pdFALSE ) )
+    {
+        if( *puxBudget == 0U )
+        {
+            #if ( configTICK_UNBLOCK_LIMIT > 0 )
+            {
+                uxWheelBacklogLeft = uxLeft;
+            }
+            #endif
+            xComplete = pdFALSE;
+            break;
+        }
+
+        ( *puxBudget )--;
+        uxLeft--;
+
+        pxItem = listGET_HEAD_ENTRY( pxSlot );
+
+        if( listGET_LIST_ITEM_VALUE( pxItem ) == xTime )
+        {
+            if( prvUnblockDelayedTask( listGET_LIST_ITEM_OWNER( pxItem ) ) != pdFALSE ) /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            {
+                *pxSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            /* A task of a later turn of the wheel goes to the back of the
+             * slot, behind the tasks still to be checked. */
+            ( void ) uxListRemove( pxItem );
+            listINSERT_END( pxSlot, pxItem );
+        }
+    }
+
+    /* Tasks unblocked by an event or deleted also leave their slot, so the
+     * bit of a slot is only cleared when the slot is found empty here. */
+    if( listLIST_IS_EMPTY( pxSlot ) != pdFALSE )
+    {
+        ulDelayedWheelUsed[ uxSlot / 32U ] &= ~( 1UL << ( uxSlot % 32U ) );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xComplete;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockDelayedTasks( const TickType_t xConstTickCount )
+{
+    UBaseType_t uxBudget = taskTICK_UNBLOCK_BUDGET;
+    BaseType_t xSwitchRequired = pdFALSE;
+
+    #if ( configTICK_UNBLOCK_LIMIT > 0 )
+    {
+        TickType_t xTime = xConstTickCount;
+        BaseType_t xBacklogLeft = pdFALSE;
+
+        if( xTickBacklog != pdFALSE )
+        {
+            xTime = xWheelBacklogTime;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Catch up slot by slot from the first tick that may still have due
+         * tasks.  Moving on to the next slot is paid from the budget like a
+         * task, so a long stretch of empty slots is bounded too. */
+        for( ; ; )
+        {
+            if( prvUnblockWheelSlot( xTime, &uxBudget, &xSwitchRequired ) == pdFALSE )
+            {
+                xBacklogLeft = pdTRUE;
+                break;
+            }
+
+            if( xTime == xConstTickCount )
+            {
+                break;
+            }
+
+            xTime++;
+
+            if( uxBudget == 0U )
+            {
+                xBacklogLeft = pdTRUE;
+                break;
+            }
+
+            uxBudget--;
+        }
+
+        xWheelBacklogTime = xTime;
+        prvRecordTickBacklog( xBacklogLeft );
+    }
+    #else /* configTICK_UNBLOCK_LIMIT */
+    {
+        /* Only the slot of this tick can hold tasks that wake now. */
+        ( void ) prvUnblockWheelSlot( xConstTickCount, &uxBudget, &xSwitchRequired );
+    }
+    #endif /* configTICK_UNBLOCK_LIMIT */
+
+    prvResetNextTaskUnblockTime();
+
+    return xSwitchRequired;
+}
+
+#else /* configUSE_TIMING_WHEEL */
+
 static void prvResetNextTaskUnblockTime( void )
 {
     if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
@@ -4017,6 +4673,243 @@ static void prvResetNextTaskUnblockTime( void )
 }
 /*-----------------------------------------------------------*/
 
+static BaseType_t prvUnblockDelayedTasks( const TickType_t xConstTickCount )
+{
+    TCB_t * pxTCB;
+    TickType_t xItemValue;
+    BaseType_t xSwitchRequired = pdFALSE;
+
+    #if ( configTICK_UNBLOCK_LIMIT > 0 )
+        UBaseType_t uxBudget = taskTICK_UNBLOCK_BUDGET;
+        BaseType_t xBacklogLeft = pdFALSE;
+
+        /* The tasks left in the delayed list when the tick count overflowed
+         * are all due, and due before any task of the delayed list. */
+        while( ( xBacklogLeft == pdFALSE ) && ( listLIST_IS_EMPTY( pxBacklogDelayedTaskList ) == pdFALSE ) )
+        {
+            if( uxBudget == 0U )
+            {
+                xBacklogLeft = pdTRUE;
+            }
+            else
+            {
+                uxBudget--;
+                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxBacklogDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                if( prvUnblockDelayedTask( pxTCB ) != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+
+        if( xBacklogLeft == pdFALSE )
+    #endif /* configTICK_UNBLOCK_LIMIT */
+    {
+        /* Tasks are stored in the queue in the order of their wake time -
+         * meaning once one task has been found whose block time has not
+         * expired there is no need to look any further down the list. */
+        for( ; ; )
+        {
+            if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+            {
+                /* The delayed list is empty.  Set xNextTaskUnblockTime
+                 * to the maximum possible value so it is extremely
+                 * unlikely that the
+                 * if( xTickCount >= xNextTaskUnblockTime ) test will pass
+                 * next time through. */
+                xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                break;
+            }
+            else
+            {
+                /* The delayed list is not empty, get the value of the
+                 * item at the head of the delayed list.  This is the time
+                 * at which the task at the head of the delayed list must
+                 * be removed from the Blocked state. */
+                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+                if( xConstTickCount < xItemValue )
+                {
+                    /* It is not time to unblock this item yet, but the
+                     * item value is the time at which the task at the head
+                     * of the blocked list must be removed from the Blocked
+                     * state -  so record the item value in
+                     * xNextTaskUnblockTime. */
+                    xNextTaskUnblockTime = xItemValue;
+                    break; /*lint !e9011 Code structure here is deemed easier to understand with multiple breaks. */
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                #if ( configTICK_UNBLOCK_LIMIT > 0 )
+                {
+                    if( uxBudget == 0U )
+                    {
+                        /* The task is due but left for a later pass, which
+                         * the past wake time in xNextTaskUnblockTime
+                         * guarantees. */
+                        xNextTaskUnblockTime = xItemValue;
+                        xBacklogLeft = pdTRUE;
+                        break; /*lint !e9011 Code structure here is deemed easier to understand with multiple breaks. */
+                    }
+
+                    uxBudget--;
+                }
+                #endif /* configTICK_UNBLOCK_LIMIT */
+
+                if( prvUnblockDelayedTask( pxTCB ) != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+    }
+
+    #if ( configTICK_UNBLOCK_LIMIT > 0 )
+    {
+        prvRecordTickBacklog( xBacklogLeft );
+    }
+    #endif
+
+    return xSwitchRequired;
+}
+
+#endif /* configUSE_TIMING_WHEEL */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockDelayedTask( TCB_t * const pxTCB )
+{
+    BaseType_t xSwitchRequired = pdFALSE;
+
+    /* It is time to remove the item from the Blocked state. */
+    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+
+    /* Is the task waiting on an event also?  If so remove it from the event
+     * list. */
+    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+    {
+        listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Place the unblocked task into the appropriate ready list. */
+    prvAddTaskToReadyList( pxTCB );
+
+    /* A task being unblocked cannot cause an immediate context switch if
+     * preemption is turned off. */
+    #if ( configUSE_PREEMPTION == 1 )
+    {
+        /* Preemption is on, but a context switch should only be performed if
+         * the unblocked task's priority is higher than the currently executing
+         * task.  The case of equal priority tasks sharing processing time
+         * (which happens when both preemption and time slicing are on) is
+         * handled in xTaskIncrementTick(). */
+        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+        {
+            xSwitchRequired = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_PREEMPTION */
+
+    return xSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configTICK_UNBLOCK_LIMIT > 0 )
+
+    static void prvRecordTickBacklog( const BaseType_t xBacklogLeft )
+    {
+        TickType_t xAge;
+
+        if( xBacklogLeft != pdFALSE )
+        {
+            if( xTickBacklog == pdFALSE )
+            {
+                xTickBacklogStart = xTickCount;
+                xTickUnblockStats.ulBacklogs++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else if( xTickBacklog != pdFALSE )
+        {
+            /* The backlog is cleared, record how many ticks it lasted. */
+            xAge = xTickCount - xTickBacklogStart;
+
+            if( xAge > xTickUnblockStats.xLongestBacklog )
+            {
+                xTickUnblockStats.xLongestBacklog = xAge;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xTickBacklog = xBacklogLeft;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskGetTickUnblockStats( TickUnblockStats_t * const pxStats )
+    {
+        TickType_t xAge;
+
+        configASSERT( pxStats );
+
+        taskENTER_CRITICAL();
+        {
+            *pxStats = xTickUnblockStats;
+
+            /* A backlog that has not cleared yet counts as it stands. */
+            if( xTickBacklog != pdFALSE )
+            {
+                xAge = xTickCount - xTickBacklogStart;
+
+                if( xAge > pxStats->xLongestBacklog )
+                {
+                    pxStats->xLongestBacklog = xAge;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configTICK_UNBLOCK_LIMIT */
+/*-----------------------------------------------------------*/
+
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
 
     TaskHandle_t xTaskGetCurrentTaskHandle( void )
@@ -5341,6 +6234,11 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
             /* The list item will be inserted in wake time order. */
             listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
+            #if ( configUSE_TIMING_WHEEL == 1 )
+            {
+                prvInsertDelayedTask( xTimeToWake, xConstTickCount );
+            }
+            #else
             if( xTimeToWake < xConstTickCount )
             {
                 /* Wake time has overflowed.  Place this item in the overflow
@@ -5365,6 +6263,7 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
+            #endif /* configUSE_TIMING_WHEEL */
         }
     }
     #else /* INCLUDE_vTaskSuspend */
@@ -5377,6 +6276,11 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
         /* The list item will be inserted in wake time order. */
         listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
+        #if ( configUSE_TIMING_WHEEL == 1 )
+        {
+            prvInsertDelayedTask( xTimeToWake, xConstTickCount );
+        }
+        #else
         if( xTimeToWake < xConstTickCount )
         {
             /* Wake time has overflowed.  Place this item in the overflow list. */
@@ -5399,6 +6303,7 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                 mtCOVERAGE_TEST_MARKER();
             }
         }
+        #endif /* configUSE_TIMING_WHEEL */
 
         /* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
         ( void ) xCanBlockIndefinitely;
@@ -0,0 +1,201 @@
+/*
+ * command.c
+ *
+ * Line-oriented command interpreter for the UART of the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#include "command.h"
+
+/**
+ * @brief Keyword of a command and whether it takes a parameter.
+ */
+typedef struct {
+    const char *pcName;
+    CommandType_t eType;
+    uint8_t ucNumeric; /**< Takes a decimal parameter instead of text */
+    uint8_t ucHasParam;
+} CommandEntry_t;
+
+static const CommandEntry_t xCommands[] = {
+    { "n", eCommandSetN, 1, 1 },
+    { "rate", eCommandSetRate, 1, 1 },
+    { "seed", eCommandSeed, 1, 1 },
+    { "filter", eCommandSetFilter, 0, 1 },
+    { "pause", eCommandPauseTop, 0, 0 },
+    { "resume", eCommandResumeTop, 0, 0 },
+    { "stats", eCommandStats, 0, 0 },
+    { "trace", eCommandTrace, 0, 0 },
+    { "help", eCommandHelp, 0, 0 }
+};
+
+/*-----------------------------------------------------------*/
+
+static char *prvSkipSpaces(char *pc)
+{
+    while (*pc == ' ')
+    {
+        pc++;
+    }
+    return pc;
+}
+
+/* Parses a whole word as a positive decimal number. */
+static BaseType_t prvParseNumber(const char *pc, int32_t *plValue)
+{
+    int32_t lValue = 0;
+
+    if (*pc == '\0')
+    {
+        return pdFALSE;
+    }
+
+    for (; *pc != '\0'; pc++)
+    {
+        if ((*pc < '0') || (*pc > '9') || (lValue > 100000))
+        {
+            return pdFALSE;
+        }
+        lValue = lValue * 10 + (*pc - '0');
+    }
+
+    *plValue = lValue;
+    return pdTRUE;
+}
+
+static BaseType_t prvStringsEqual(const char *pcA, const char *pcB)
+{
+    while ((*pcA != '\0') && (*pcA == *pcB))
+    {
+        pcA++;
+        pcB++;
+    }
+    return (*pcA == *pcB) ? pdTRUE : pdFALSE;
+}
+
+/*-----------------------------------------------------------*/
+
+void vCommandLineReset(CommandLine_t *pxLine)
+{
+    pxLine->ucLength = 0;
+    pxLine->ucOverflow = 0;
+    pxLine->pcBuffer[0] = '\0';
+}
+
+BaseType_t xCommandLineAddChar(CommandLine_t *pxLine, char c, char *pcEcho)
+{
+    pcEcho[0] = '\0';
+
+    if ((c == '\r') || (c == '\n'))
+    {
+        pxLine->pcBuffer[pxLine->ucLength] = '\0';
+        pcEcho[0] = '\r';
+        pcEcho[1] = '\n';
+        pcEcho[2] = '\0';
+        return pdTRUE;
+    }
+
+    if ((c == '\b') || (c == 0x7F))
+    {
+        if (pxLine->ucLength > 0)
+        {
+            // Move back, blank the character and move back again
+            pxLine->ucLength--;
+            pcEcho[0] = '\b';
+            pcEcho[1] = ' ';
+            pcEcho[2] = '\b';
+            pcEcho[3] = '\0';
+        }
+        return pdFALSE;
+    }
+
+    if ((c < ' ') || (c > '~'))
+    {
+        return pdFALSE;
+    }
+
+    if (pxLine->ucLength < commandLINE_LEN - 1)
+    {
+        // Stored lowercase so commands are not case sensitive
+        pxLine->pcBuffer[pxLine->ucLength++] = ((c >= 'A') && (c <= 'Z')) ? (char)(c - 'A' + 'a') : c;
+        pcEcho[0] = c;
+        pcEcho[1] = '\0';
+    }
+    else
+    {
+        pxLine->ucOverflow = 1;
+    }
+
+    return pdFALSE;
+}
+
+void vCommandParse(CommandLine_t *pxLine, Command_t *pxCommand)
+{
+    char *pcWord;
+    char *pcParam;
+    char *pcEnd;
+    UBaseType_t x;
+
+    pxCommand->eType = eCommandInvalid;
+    pxCommand->lValue = 0;
+    pxCommand->pcText = "";
+
+    if (pxLine->ucOverflow != 0)
+    {
+        return;
+    }
+
+    // Split the line into the keyword and the rest, without trailing spaces
+    pcWord = prvSkipSpaces(pxLine->pcBuffer);
+    if (*pcWord == '\0')
+    {
+        pxCommand->eType = eCommandNone;
+        return;
+    }
+
+    pcEnd = pxLine->pcBuffer + pxLine->ucLength;
+    while ((pcEnd > pcWord) && (pcEnd[-1] == ' '))
+    {
+        pcEnd--;
+    }
+    *pcEnd = '\0';
+
+    for (pcParam = pcWord; (*pcParam != '\0') && (*pcParam != ' '); pcParam++)
+    {
+    }
+    if (*pcParam != '\0')
+    {
+        *pcParam = '\0';
+        pcParam = prvSkipSpaces(pcParam + 1);
+    }
+
+    // A bare number sets N, as the single digit input used to
+    if (prvParseNumber(pcWord, &pxCommand->lValue) == pdTRUE)
+    {
+        pxCommand->eType = (*pcParam == '\0') ? eCommandSetN : eCommandInvalid;
+        return;
+    }
+
+    for (x = 0; x < sizeof(xCommands) / sizeof(xCommands[0]); x++)
+    {
+        if (prvStringsEqual(pcWord, xCommands[x].pcName) == pdFALSE)
+        {
+            continue;
+        }
+
+        if ((xCommands[x].ucHasParam != 0) != (*pcParam != '\0'))
+        {
+            return;
+        }
+        if ((xCommands[x].ucNumeric != 0) && (prvParseNumber(pcParam, &pxCommand->lValue) == pdFALSE))
+        {
+            return;
+        }
+
+        pxCommand->eType = xCommands[x].eType;
+        pxCommand->pcText = pcParam;
+        return;
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * command.h
+ *
+ * Line-oriented command interpreter for the UART of the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#ifndef COMMAND_H
+#define COMMAND_H
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+/* Configuration of the command interpreter. */
+#define commandLINE_LEN 32 // Max length of a command line, including the terminator
+
+/**
+ * @brief Commands understood by the interpreter.
+ */
+typedef enum {
+    eCommandNone,      /**< Empty line */
+    eCommandInvalid,   /**< Unknown command, missing or malformed parameter */
+    eCommandSetN,      /**< "n <value>" or just "<value>": length of the boxcar filter */
+    eCommandSetRate,   /**< "rate <hz>": sample rate of the temperature sensor */
+    eCommandSeed,      /**< "seed <value>": restarts the simulated temperatures from a seed */
+    eCommandSetFilter, /**< "filter <spec>": filter chain specification, e.g. "m5,b8,d2" */
+    eCommandPauseTop,  /**< "pause": stops the periodic top table */
+    eCommandResumeTop, /**< "resume": restarts the periodic top table */
+    eCommandStats,     /**< "stats": prints the top table right away */
+    eCommandTrace,     /**< "trace": sends the records of the trace recorder as binary frames */
+    eCommandHelp       /**< "help": lists the commands */
+} CommandType_t;
+
+/**
+ * @brief A parsed command line.
+ */
+typedef struct {
+    CommandType_t eType; /**< Command given */
+    int32_t lValue;      /**< Numeric parameter of eCommandSetN, eCommandSetRate and eCommandSeed */
+    const char *pcText;  /**< Text parameter of eCommandSetFilter, points into the parsed line */
+} Command_t;
+
+/**
+ * @brief Command line being typed, with a line editor behaviour.
+ */
+typedef struct {
+    char pcBuffer[commandLINE_LEN]; /**< Characters typed so far, null-terminated once complete */
+    uint8_t ucLength;               /**< Number of characters in pcBuffer */
+    uint8_t ucOverflow;             /**< Set when the line got longer than the buffer */
+} CommandLine_t;
+
+/**
+ * @brief Empties a command line.
+ *
+ * @param pxLine Line to reset.
+ */
+void vCommandLineReset(CommandLine_t *pxLine);
+
+/**
+ * @brief Adds a received character to a command line.
+ *
+ * Backspace removes the last character, carriage return or line feed ends the
+ * line.  Characters past the capacity of the line are dropped and the line is
+ * reported as invalid once complete.
+ *
+ * @param pxLine Line being typed.
+ * @param c Received character.
+ * @param pcEcho Receives the characters to echo back, at most 3 plus the terminator.
+ * @return BaseType_t pdTRUE when the line is complete and ready for xCommandParse().
+ */
+BaseType_t xCommandLineAddChar(CommandLine_t *pxLine, char c, char *pcEcho);
+
+/**
+ * @brief Parses a complete command line.
+ *
+ * Only checks the syntax, the ranges of the parameters are left to the caller.
+ *
+ * @param pxLine Complete line, its buffer is modified.
+ * @param pxCommand Receives the command.
+ */
+void vCommandParse(CommandLine_t *pxLine, Command_t *pxCommand);
+
+#endif /* COMMAND_H */
@@ -0,0 +1,38 @@
+/*
+ * cyclecount.h
+ *
+ * Core clock cycle measurement for the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#ifndef CYCLECOUNT_H
+#define CYCLECOUNT_H
+
+#include <stdint.h>
+
+/*
+ * The SysTick timer used by the FreeRTOS port counts down at the core clock
+ * and reloads every tick, so the difference between two readings is a cycle
+ * count as long as the measured code takes less than one tick.
+ */
+#define cycleSYSTICK_LOAD_REG       ( *( ( volatile uint32_t * ) 0xe000e014 ) )
+#define cycleSYSTICK_CURRENT_REG    ( *( ( volatile uint32_t * ) 0xe000e018 ) )
+
+/**
+ * @brief Reads the current position of the cycle counter.
+ */
+#define ulCycleCountGet()    ( cycleSYSTICK_CURRENT_REG )
+
+/**
+ * @brief Cycles elapsed between two readings of ulCycleCountGet().
+ *
+ * @param ulStart Reading taken before the measured code.
+ * @param ulEnd Reading taken after the measured code.
+ */
+#define ulCycleCountElapsed( ulStart, ulEnd )                                  \
+    ( ( ( ulStart ) >= ( ulEnd ) ) ? ( ( ulStart ) - ( ulEnd ) ) :            \
+      ( ( ulStart ) + cycleSYSTICK_LOAD_REG + 1UL - ( ulEnd ) ) )
+
+#endif /* CYCLECOUNT_H */
@@ -0,0 +1,485 @@
+/*
+ * filter_chain.c
+ *
+ * Composable fixed-point filter chain for the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#include "filter_chain.h"
+#include "task.h"
+#include "cyclecount.h"
+
+/* Default parameters of the stages given without one in a specification. */
+#define filterDEFAULT_IIR_SHIFT       3
+#define filterDEFAULT_FIR_TAPS        8
+#define filterDEFAULT_MEDIAN_WINDOW   5
+#define filterDEFAULT_DECIMATION      2
+#define filterMAX_IIR_SHIFT           12
+#define filterMAX_DECIMATION          1000
+
+/*-----------------------------------------------------------*/
+
+/* Clamps a sample to the 16 bits of the FIR and median histories instead of letting it wrap. */
+static int16_t prvSaturate16(int32_t lSample)
+{
+    if (lSample > INT16_MAX)
+    {
+        return INT16_MAX;
+    }
+    if (lSample < INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+    return (int16_t)lSample;
+}
+
+/* Same for the boxcar histories, stored as MovAvgSample_t. */
+static MovAvgSample_t prvSaturateBoxcar(int32_t lSample)
+{
+    if (lSample > movavgSAMPLE_MAX)
+    {
+        return movavgSAMPLE_MAX;
+    }
+    if (lSample < movavgSAMPLE_MIN)
+    {
+        return movavgSAMPLE_MIN;
+    }
+    return (MovAvgSample_t)lSample;
+}
+
+/* Divides rounding to the nearest integer, half away from zero. */
+static int32_t prvDivideRounded(int32_t lValue, int32_t lDivisor)
+{
+    if (lValue >= 0)
+    {
+        return (lValue + (lDivisor / 2)) / lDivisor;
+    }
+
+    return -((-lValue + (lDivisor / 2)) / lDivisor);
+}
+
+/* Fills the coefficients of a FIR stage with a triangular (Bartlett) window of unity gain. */
+static void prvFIRDefaultCoefficients(FilterStage_t *pxStage)
+{
+    uint16_t usTaps = pxStage->usParam;
+    int32_t lWeightSum = 0;
+    int32_t lCoeffSum = 0;
+    uint16_t k;
+
+    for (k = 0; k < usTaps; k++)
+    {
+        lWeightSum += (k < usTaps - k) ? (k + 1) : (usTaps - k);
+    }
+
+    for (k = 0; k < usTaps; k++)
+    {
+        int32_t lWeight = (k < usTaps - k) ? (k + 1) : (usTaps - k);
+        int32_t lCoeff = (lWeight << filterCOEFF_FRACTION_BITS) / lWeightSum;
+
+        pxStage->u.xFIR.psCoeff[k] = (int16_t)lCoeff;
+        lCoeffSum += lCoeff;
+    }
+
+    // Give the truncation error to the centre tap so that the gain stays at one
+    lCoeffSum = pxStage->u.xFIR.psCoeff[usTaps / 2] + ((1L << filterCOEFF_FRACTION_BITS) - lCoeffSum);
+    pxStage->u.xFIR.psCoeff[usTaps / 2] = (int16_t)((lCoeffSum > 32767) ? 32767 : lCoeffSum);
+}
+
+static uint16_t prvDefaultParam(const FilterChain_t *pxChain, FilterType_t eType)
+{
+    switch (eType)
+    {
+        case eFilterBoxcar:   return pxChain->usWindow;
+        case eFilterIIR:      return filterDEFAULT_IIR_SHIFT;
+        case eFilterFIR:      return filterDEFAULT_FIR_TAPS;
+        case eFilterMedian:   return filterDEFAULT_MEDIAN_WINDOW;
+        case eFilterDecimate: return filterDEFAULT_DECIMATION;
+        default:              return 0;
+    }
+}
+
+static BaseType_t prvParamValid(FilterType_t eType, uint32_t ulParam)
+{
+    switch (eType)
+    {
+        case eFilterBoxcar:   return (ulParam >= 1) && (ulParam <= 0xFFFF);
+        case eFilterIIR:      return (ulParam >= 1) && (ulParam <= filterMAX_IIR_SHIFT);
+        case eFilterFIR:      return (ulParam >= 1) && (ulParam <= filterFIR_MAX_TAPS);
+        case eFilterMedian:   return (ulParam >= 1) && (ulParam <= filterMEDIAN_MAX_WINDOW);
+        case eFilterDecimate: return (ulParam >= 1) && (ulParam <= filterMAX_DECIMATION);
+        default:              return pdFALSE;
+    }
+}
+
+/* Clears the state of every stage and splits the history pool between the boxcar stages. */
+static void prvResetStages(FilterChain_t *pxChain)
+{
+    UBaseType_t uxBoxcars = 0;
+    UBaseType_t uxBoxcar = 0;
+    UBaseType_t x;
+
+    for (x = 0; x < pxChain->uxStages; x++)
+    {
+        if (pxChain->xStages[x].eType == eFilterBoxcar)
+        {
+            uxBoxcars++;
+        }
+    }
+
+    for (x = 0; x < pxChain->uxStages; x++)
+    {
+        FilterStage_t *pxStage = &pxChain->xStages[x];
+
+        pxStage->ucPrimed = 0;
+        pxStage->ulCycles = 0;
+        pxStage->ulSamples = 0;
+
+        switch (pxStage->eType)
+        {
+            case eFilterBoxcar:
+            {
+                uint16_t usSlice = pxChain->usPoolSize / uxBoxcars;
+
+                vMovingAverageInit(&pxStage->u.xBoxcar, pxChain->psPool + (uxBoxcar * usSlice), usSlice, pxStage->usParam);
+                pxStage->usParam = pxStage->u.xBoxcar.usWindow; // The window is clamped to the slice of the pool
+                uxBoxcar++;
+                break;
+            }
+            case eFilterIIR:
+                pxStage->u.lIIR = 0;
+                break;
+            case eFilterFIR:
+                pxStage->u.xFIR.ucHead = 0;
+                prvFIRDefaultCoefficients(pxStage);
+                break;
+            case eFilterMedian:
+                pxStage->u.xMedian.ucHead = 0;
+                pxStage->u.xMedian.ucCount = 0;
+                break;
+            case eFilterDecimate:
+                pxStage->u.xDecimate.lAccumulator = 0;
+                pxStage->u.xDecimate.usCount = 0;
+                break;
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static int32_t prvProcessFIR(FilterStage_t *pxStage, int32_t lSample)
+{
+    uint8_t ucTaps = (uint8_t)pxStage->usParam;
+    int16_t sSample = prvSaturate16(lSample);
+    uint8_t ucIndex;
+    int64_t llAccumulator = 0;
+    uint8_t k;
+
+    // Start from a history full of the first sample instead of a step from zero
+    if (!pxStage->ucPrimed)
+    {
+        for (k = 0; k < ucTaps; k++)
+        {
+            pxStage->u.xFIR.psHistory[k] = sSample;
+        }
+    }
+
+    pxStage->u.xFIR.psHistory[pxStage->u.xFIR.ucHead] = sSample;
+
+    // Coefficient k applies to the k-th newest sample
+    ucIndex = pxStage->u.xFIR.ucHead;
+    for (k = 0; k < ucTaps; k++)
+    {
+        llAccumulator += (int32_t)pxStage->u.xFIR.psCoeff[k] * pxStage->u.xFIR.psHistory[ucIndex];
+        ucIndex = (ucIndex == 0) ? (ucTaps - 1) : (ucIndex - 1);
+    }
+
+    if (++pxStage->u.xFIR.ucHead == ucTaps)
+    {
+        pxStage->u.xFIR.ucHead = 0;
+    }
+
+    return (int32_t)((llAccumulator + (1L << (filterCOEFF_FRACTION_BITS - 1))) >> filterCOEFF_FRACTION_BITS);
+}
+
+static int32_t prvProcessMedian(FilterStage_t *pxStage, int32_t lSample)
+{
+    uint8_t ucWindow = (uint8_t)pxStage->usParam;
+    int16_t *psSorted = pxStage->u.xMedian.psSorted;
+    int16_t sSample = prvSaturate16(lSample);
+    uint8_t ucCount = pxStage->u.xMedian.ucCount;
+    uint8_t i;
+
+    // Drop the oldest sample from the sorted copy once the window is full
+    if (ucCount == ucWindow)
+    {
+        int16_t sOldest = pxStage->u.xMedian.psWindow[pxStage->u.xMedian.ucHead];
+
+        for (i = 0; psSorted[i] != sOldest; i++)
+        {
+        }
+        for (; i < ucCount - 1; i++)
+        {
+            psSorted[i] = psSorted[i + 1];
+        }
+        ucCount--;
+    }
+
+    pxStage->u.xMedian.psWindow[pxStage->u.xMedian.ucHead] = sSample;
+    if (++pxStage->u.xMedian.ucHead == ucWindow)
+    {
+        pxStage->u.xMedian.ucHead = 0;
+    }
+
+    // Insertion keeps the copy sorted
+    for (i = ucCount; (i > 0) && (psSorted[i - 1] > sSample); i--)
+    {
+        psSorted[i] = psSorted[i - 1];
+    }
+    psSorted[i] = sSample;
+    ucCount++;
+
+    pxStage->u.xMedian.ucCount = ucCount;
+
+    return psSorted[ucCount / 2];
+}
+
+/* Runs a single stage, returns pdFALSE when the stage produces no output for this sample. */
+static BaseType_t prvProcessStage(FilterStage_t *pxStage, int32_t lSample, int32_t *plOutput)
+{
+    BaseType_t xProduced = pdTRUE;
+
+    switch (pxStage->eType)
+    {
+        case eFilterBoxcar:
+            *plOutput = lMovingAverageAdd(&pxStage->u.xBoxcar, prvSaturateBoxcar(lSample));
+            break;
+
+        case eFilterIIR:
+            if (!pxStage->ucPrimed)
+            {
+                pxStage->u.lIIR = lSample << filterMAX_IIR_SHIFT;
+            }
+            // The state keeps extra fractional bits so that small steps are not lost
+            pxStage->u.lIIR += ((lSample << filterMAX_IIR_SHIFT) - pxStage->u.lIIR) >> pxStage->usParam;
+            *plOutput = (pxStage->u.lIIR + (1L << (filterMAX_IIR_SHIFT - 1))) >> filterMAX_IIR_SHIFT;
+            break;
+
+        case eFilterFIR:
+            *plOutput = prvProcessFIR(pxStage, lSample);
+            break;
+
+        case eFilterMedian:
+            *plOutput = prvProcessMedian(pxStage, lSample);
+            break;
+
+        case eFilterDecimate:
+            pxStage->u.xDecimate.lAccumulator += lSample;
+            if (++pxStage->u.xDecimate.usCount < pxStage->usParam)
+            {
+                xProduced = pdFALSE;
+            }
+            else
+            {
+                *plOutput = prvDivideRounded(pxStage->u.xDecimate.lAccumulator, pxStage->usParam);
+                pxStage->u.xDecimate.lAccumulator = 0;
+                pxStage->u.xDecimate.usCount = 0;
+            }
+            break;
+
+        default:
+            *plOutput = lSample;
+            break;
+    }
+
+    pxStage->ucPrimed = 1;
+
+    return xProduced;
+}
+
+/*-----------------------------------------------------------*/
+
+void vFilterChainInit(FilterChain_t *pxChain, MovAvgSample_t *psPool, uint16_t usPoolSize, uint16_t usWindow)
+{
+    pxChain->psPool = psPool;
+    pxChain->usPoolSize = usPoolSize;
+    pxChain->usWindow = usWindow;
+    pxChain->uxStages = 1;
+    pxChain->xStages[0].eType = eFilterBoxcar;
+    pxChain->xStages[0].usParam = usWindow;
+    prvResetStages(pxChain);
+}
+
+BaseType_t xFilterChainConfigure(FilterChain_t *pxChain, const char *pcSpec)
+{
+    FilterType_t peTypes[filterMAX_STAGES];
+    uint16_t pusParams[filterMAX_STAGES];
+    UBaseType_t uxStages = 0;
+    UBaseType_t x;
+
+    // Parse the whole specification before touching the chain
+    while (*pcSpec != '\0')
+    {
+        FilterType_t eType = (FilterType_t)*pcSpec;
+        uint32_t ulParam = 0;
+        BaseType_t xHasParam = pdFALSE;
+
+        if ((*pcSpec == ',') || (*pcSpec == ' '))
+        {
+            pcSpec++;
+            continue;
+        }
+
+        if ((uxStages == filterMAX_STAGES) || !prvParamValid(eType, 1))
+        {
+            return pdFAIL;
+        }
+
+        for (pcSpec++; (*pcSpec >= '0') && (*pcSpec <= '9'); pcSpec++)
+        {
+            ulParam = (ulParam * 10) + (*pcSpec - '0');
+            xHasParam = pdTRUE;
+            if (ulParam > 0xFFFF)
+            {
+                return pdFAIL;
+            }
+        }
+
+        if (!xHasParam)
+        {
+            ulParam = prvDefaultParam(pxChain, eType);
+        }
+        if (!prvParamValid(eType, ulParam))
+        {
+            return pdFAIL;
+        }
+
+        peTypes[uxStages] = eType;
+        pusParams[uxStages] = (uint16_t)ulParam;
+        uxStages++;
+    }
+
+    if (uxStages == 0)
+    {
+        return pdFAIL;
+    }
+
+    for (x = 0; x < uxStages; x++)
+    {
+        pxChain->xStages[x].eType = peTypes[x];
+        pxChain->xStages[x].usParam = pusParams[x];
+    }
+    pxChain->uxStages = uxStages;
+    prvResetStages(pxChain);
+
+    return pdPASS;
+}
+
+void vFilterChainSetWindow(FilterChain_t *pxChain, uint16_t usWindow)
+{
+    UBaseType_t x;
+
+    pxChain->usWindow = usWindow;
+
+    for (x = 0; x < pxChain->uxStages; x++)
+    {
+        if (pxChain->xStages[x].eType == eFilterBoxcar)
+        {
+            vMovingAverageSetWindow(&pxChain->xStages[x].u.xBoxcar, usWindow);
+            pxChain->xStages[x].usParam = pxChain->xStages[x].u.xBoxcar.usWindow;
+        }
+    }
+}
+
+BaseType_t xFilterChainSetCoefficients(FilterChain_t *pxChain, UBaseType_t uxStage, const int16_t *psCoeff, UBaseType_t uxTaps)
+{
+    FilterStage_t *pxStage;
+    UBaseType_t k;
+
+    if ((uxStage >= pxChain->uxStages) || (uxTaps < 1) || (uxTaps > filterFIR_MAX_TAPS))
+    {
+        return pdFAIL;
+    }
+
+    pxStage = &pxChain->xStages[uxStage];
+    if (pxStage->eType != eFilterFIR)
+    {
+        return pdFAIL;
+    }
+
+    pxStage->usParam = (uint16_t)uxTaps;
+    for (k = 0; k < uxTaps; k++)
+    {
+        pxStage->u.xFIR.psCoeff[k] = psCoeff[k];
+    }
+    pxStage->u.xFIR.ucHead = 0;
+    pxStage->ucPrimed = 0;
+
+    return pdPASS;
+}
+
+BaseType_t xFilterChainProcess(FilterChain_t *pxChain, int32_t lSample, int32_t *plOutput)
+{
+    int32_t lValue = lSample << filterFRACTION_BITS;
+    UBaseType_t x;
+
+    for (x = 0; x < pxChain->uxStages; x++)
+    {
+        FilterStage_t *pxStage = &pxChain->xStages[x];
+        uint32_t ulStart = ulCycleCountGet();
+        BaseType_t xProduced = prvProcessStage(pxStage, lValue, &lValue);
+        uint32_t ulEnd = ulCycleCountGet();
+
+        pxStage->ulCycles += ulCycleCountElapsed(ulStart, ulEnd);
+        pxStage->ulSamples++;
+
+        if (xProduced == pdFALSE)
+        {
+            return pdFALSE;
+        }
+    }
+
+    *plOutput = prvDivideRounded(lValue, 1L << filterFRACTION_BITS);
+
+    return pdTRUE;
+}
+
+BaseType_t xFilterChainGetStageStats(FilterChain_t *pxChain, UBaseType_t uxStage, FilterType_t *peType, uint16_t *pusParam, uint32_t *pulCyclesPerSample)
+{
+    uint32_t ulCycles, ulSamples;
+
+    taskENTER_CRITICAL();
+    {
+        if (uxStage >= pxChain->uxStages)
+        {
+            taskEXIT_CRITICAL();
+            return pdFALSE;
+        }
+
+        *peType = pxChain->xStages[uxStage].eType;
+        *pusParam = pxChain->xStages[uxStage].usParam;
+        ulCycles = pxChain->xStages[uxStage].ulCycles;
+        ulSamples = pxChain->xStages[uxStage].ulSamples;
+        pxChain->xStages[uxStage].ulCycles = 0;
+        pxChain->xStages[uxStage].ulSamples = 0;
+    }
+    taskEXIT_CRITICAL();
+
+    *pulCyclesPerSample = (ulSamples > 0) ? (ulCycles / ulSamples) : 0;
+
+    return pdTRUE;
+}
+
+const char *pcFilterTypeName(FilterType_t eType)
+{
+    switch (eType)
+    {
+        case eFilterBoxcar:   return "Boxcar";
+        case eFilterIIR:      return "IIR";
+        case eFilterFIR:      return "FIR";
+        case eFilterMedian:   return "Median";
+        case eFilterDecimate: return "Decimate";
+        default:              return "Unknown";
+    }
+}
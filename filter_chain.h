@@ -0,0 +1,155 @@
+/*
+ * filter_chain.h
+ *
+ * Composable fixed-point filter chain for the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#ifndef FILTER_CHAIN_H
+#define FILTER_CHAIN_H
+
+#include "FreeRTOS.h"
+#include "movavg.h"
+
+/* Configuration of the filter chain. */
+#define filterMAX_STAGES          4  // Max number of stages in a chain
+#define filterFIR_MAX_TAPS        16 // Max number of coefficients of a FIR stage
+#define filterMEDIAN_MAX_WINDOW   9  // Max window of a running median stage
+#define filterFRACTION_BITS       8  // Fractional bits of the samples flowing between stages
+#define filterCOEFF_FRACTION_BITS 15 // Fractional bits of the FIR coefficients
+
+/**
+ * @brief Kind of filter stage, identified by the letter used in a chain specification.
+ */
+typedef enum {
+    eFilterBoxcar = 'b',   /**< Moving average over N samples */
+    eFilterIIR = 'i',      /**< Exponential smoothing, y += (x - y) / 2^k */
+    eFilterFIR = 'f',      /**< FIR with Q15 coefficients (triangular window by default) */
+    eFilterMedian = 'm',   /**< Running median over a short window */
+    eFilterDecimate = 'd'  /**< Outputs the mean of every block of D samples */
+} FilterType_t;
+
+/**
+ * @brief A single stage of the chain with its state and cost accounting.
+ */
+typedef struct {
+    FilterType_t eType;     /**< Kind of stage */
+    uint16_t usParam;       /**< Window, shift, taps or decimation factor */
+    union {
+        MovingAverage_t xBoxcar;
+        int32_t lIIR;
+        struct {
+            int16_t psCoeff[filterFIR_MAX_TAPS];
+            int16_t psHistory[filterFIR_MAX_TAPS];
+            uint8_t ucHead;
+        } xFIR;
+        struct {
+            int16_t psWindow[filterMEDIAN_MAX_WINDOW];
+            int16_t psSorted[filterMEDIAN_MAX_WINDOW];
+            uint8_t ucHead;
+            uint8_t ucCount;
+        } xMedian;
+        struct {
+            int32_t lAccumulator;
+            uint16_t usCount;
+        } xDecimate;
+    } u;                    /**< State of the stage, depending on eType */
+    uint8_t ucPrimed;       /**< Set once the stage has received its first sample */
+    uint32_t ulCycles;      /**< Cycles spent in the stage since the last statistics read */
+    uint32_t ulSamples;     /**< Samples processed since the last statistics read */
+} FilterStage_t;
+
+/**
+ * @brief A chain of filter stages applied in order to every sample.
+ */
+typedef struct {
+    FilterStage_t xStages[filterMAX_STAGES]; /**< Stages, in processing order */
+    UBaseType_t uxStages;                    /**< Number of stages in use */
+    MovAvgSample_t *psPool;                  /**< History storage shared by the boxcar stages */
+    uint16_t usPoolSize;                     /**< Number of entries in psPool */
+    uint16_t usWindow;                       /**< Window of the boxcar stages given without a parameter */
+} FilterChain_t;
+
+/**
+ * @brief Initialises a chain with a single boxcar stage.
+ *
+ * @param pxChain Chain to initialise.
+ * @param psPool Storage for the boxcar histories, split between the boxcar stages.
+ * @param usPoolSize Number of entries in psPool.
+ * @param usWindow Window of the initial boxcar stage.
+ */
+void vFilterChainInit(FilterChain_t *pxChain, MovAvgSample_t *psPool, uint16_t usPoolSize, uint16_t usWindow);
+
+/**
+ * @brief Replaces the stages of the chain from a textual specification.
+ *
+ * The specification is a list of stages separated by commas or spaces, each
+ * made of the stage letter (see FilterType_t) optionally followed by its
+ * parameter, e.g. "m5,b16,d4".  Stages without a parameter use a default.
+ * The state of every stage is reset.
+ *
+ * @param pxChain Chain to configure.
+ * @param pcSpec Null-terminated specification.
+ * @return BaseType_t pdPASS if the chain was replaced, pdFAIL if the specification
+ *         is invalid, in which case the chain is left untouched.
+ */
+BaseType_t xFilterChainConfigure(FilterChain_t *pxChain, const char *pcSpec);
+
+/**
+ * @brief Sets the window of every boxcar stage of the chain.
+ *
+ * @param pxChain Chain to update.
+ * @param usWindow New window length.
+ */
+void vFilterChainSetWindow(FilterChain_t *pxChain, uint16_t usWindow);
+
+/**
+ * @brief Replaces the coefficients of a FIR stage.
+ *
+ * @param pxChain Chain holding the stage.
+ * @param uxStage Index of the stage.
+ * @param psCoeff Coefficients with filterCOEFF_FRACTION_BITS fractional bits.
+ * @param uxTaps Number of coefficients, at most filterFIR_MAX_TAPS.
+ * @return BaseType_t pdPASS on success, pdFAIL if the stage is not a FIR stage.
+ */
+BaseType_t xFilterChainSetCoefficients(FilterChain_t *pxChain, UBaseType_t uxStage, const int16_t *psCoeff, UBaseType_t uxTaps);
+
+/**
+ * @brief Runs a sample through every stage of the chain.
+ *
+ * Samples flow between the stages with filterFRACTION_BITS fractional bits,
+ * and the boxcar, FIR and median stages keep them in 16 bits.  Inputs and
+ * intermediate values are therefore exact in [-128, 127], the temperatures
+ * of this program being 0 to 99, and saturate to that range outside it.
+ *
+ * @param pxChain Chain to run.
+ * @param lSample Input sample, in [-128, 127].
+ * @param plOutput Filtered sample, written only when the function returns pdTRUE.
+ * @return BaseType_t pdTRUE if a sample came out of the chain, pdFALSE if a
+ *         decimating stage absorbed it.
+ */
+BaseType_t xFilterChainProcess(FilterChain_t *pxChain, int32_t lSample, int32_t *plOutput);
+
+/**
+ * @brief Reads and clears the cost accounting of a stage.
+ *
+ * @param pxChain Chain holding the stage.
+ * @param uxStage Index of the stage.
+ * @param peType Receives the kind of the stage.
+ * @param pusParam Receives the parameter of the stage.
+ * @param pulCyclesPerSample Average number of cycles per input sample since the last call.
+ * @return BaseType_t pdFALSE if uxStage is past the end of the chain.
+ */
+BaseType_t xFilterChainGetStageStats(FilterChain_t *pxChain, UBaseType_t uxStage, FilterType_t *peType, uint16_t *pusParam, uint32_t *pulCyclesPerSample);
+
+/**
+ * @brief Returns the name of a kind of stage.
+ *
+ * @param eType Kind of stage.
+ * @return A string naming the stage.
+ */
+const char *pcFilterTypeName(FilterType_t eType);
+
+#endif /* FILTER_CHAIN_H */
@@ -0,0 +1,171 @@
+/*
+ * framebuffer.c
+ *
+ * Column framebuffer for the OSRAM 96x16 display of the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#include "hw_types.h"
+#include "osram96x16.h"
+#include "framebuffer.h"
+
+/*-----------------------------------------------------------*/
+
+/* Column of the ring shown at a given screen position. */
+static uint16_t prvColumnAt(const Framebuffer_t *pxFb, uint32_t ulX)
+{
+    if (pxFb->eMode == eFramebufferSweep)
+    {
+        return pxFb->pusColumns[ulX];
+    }
+
+    // The newest column is at the left edge
+    return pxFb->pusColumns[(pxFb->ucHead + fbWIDTH - ulX) % fbWIDTH];
+}
+
+/* Byte of a column that belongs to a display row, row 0 being the top half. */
+static unsigned char prvRowByte(uint16_t usColumn, uint32_t ulRow)
+{
+    return (unsigned char)(usColumn >> (8 * ulRow));
+}
+
+static void prvMarkDirty(Framebuffer_t *pxFb, uint32_t ulX)
+{
+    pxFb->pulDirty[ulX / 32] |= (1UL << (ulX % 32));
+}
+
+static int prvIsDirty(const Framebuffer_t *pxFb, uint32_t ulX)
+{
+    return (pxFb->pulDirty[ulX / 32] & (1UL << (ulX % 32))) != 0;
+}
+
+/* Whether a row of a screen column differs from what the display shows. */
+static int prvRowChanged(const Framebuffer_t *pxFb, uint32_t ulX, uint32_t ulRow)
+{
+    return prvIsDirty(pxFb, ulX) &&
+           (prvRowByte(prvColumnAt(pxFb, ulX), ulRow) != prvRowByte(pxFb->pusShown[ulX], ulRow));
+}
+
+/*-----------------------------------------------------------*/
+
+void vFramebufferInit(Framebuffer_t *pxFb, FramebufferMode_t eMode)
+{
+    uint32_t ulX;
+
+    for (ulX = 0; ulX < fbWIDTH; ulX++)
+    {
+        pxFb->pusColumns[ulX] = 0;
+        pxFb->pusShown[ulX] = 0;
+    }
+    for (ulX = 0; ulX < sizeof(pxFb->pulDirty) / sizeof(pxFb->pulDirty[0]); ulX++)
+    {
+        pxFb->pulDirty[ulX] = 0;
+    }
+    pxFb->ucHead = 0;
+    pxFb->eMode = eMode;
+    pxFb->ulBytesSent = 0;
+
+    // The only full clear, afterwards the display always matches pusShown
+    OSRAMClear();
+}
+
+uint16_t usFramebufferPoint(int32_t lValue)
+{
+    if (lValue < 0)
+    {
+        lValue = 0;
+    }
+    if (lValue > fbHEIGHT - 1)
+    {
+        lValue = fbHEIGHT - 1;
+    }
+
+    // Bit 0 is the top scan line, the value grows upwards
+    return (uint16_t)(1U << (fbHEIGHT - 1 - lValue));
+}
+
+uint16_t usFramebufferRange(int32_t lLowest, int32_t lHighest)
+{
+    uint16_t usTop = usFramebufferPoint(lHighest);
+    uint16_t usBottom = usFramebufferPoint(lLowest);
+
+    // Every bit from the top point down to the bottom point
+    return (uint16_t)((usBottom - usTop) | usBottom);
+}
+
+void vFramebufferPushColumn(Framebuffer_t *pxFb, uint16_t usColumn)
+{
+    uint32_t ulX;
+
+    pxFb->ucHead = (pxFb->ucHead + 1) % fbWIDTH;
+    pxFb->pusColumns[pxFb->ucHead] = usColumn;
+
+    if (pxFb->eMode == eFramebufferSweep)
+    {
+        // Only the new column and the blank cursor ahead of it move
+        pxFb->pusColumns[(pxFb->ucHead + 1) % fbWIDTH] = 0;
+        prvMarkDirty(pxFb, pxFb->ucHead);
+        prvMarkDirty(pxFb, (pxFb->ucHead + 1) % fbWIDTH);
+    }
+    else
+    {
+        // Every screen position shows a different column now, the flush sends only the ones that differ
+        for (ulX = 0; ulX < sizeof(pxFb->pulDirty) / sizeof(pxFb->pulDirty[0]); ulX++)
+        {
+            pxFb->pulDirty[ulX] = 0xFFFFFFFFUL;
+        }
+    }
+}
+
+void vFramebufferFlush(Framebuffer_t *pxFb)
+{
+    unsigned char pucRun[fbWIDTH];
+    uint32_t ulRow, ulX, ulStart, ulEnd, ulScan, i;
+
+    for (ulRow = 0; ulRow < fbHEIGHT / 8; ulRow++)
+    {
+        ulX = 0;
+        while (ulX < fbWIDTH)
+        {
+            if (!prvRowChanged(pxFb, ulX, ulRow))
+            {
+                ulX++;
+                continue;
+            }
+
+            // Extend the run over short gaps of unchanged columns
+            ulStart = ulX;
+            ulEnd = ulX;
+            for (ulScan = ulX + 1; (ulScan < fbWIDTH) && (ulScan - ulEnd <= fbMERGE_GAP); ulScan++)
+            {
+                if (prvRowChanged(pxFb, ulScan, ulRow))
+                {
+                    ulEnd = ulScan;
+                }
+            }
+
+            for (i = ulStart; i <= ulEnd; i++)
+            {
+                pucRun[i - ulStart] = prvRowByte(prvColumnAt(pxFb, i), ulRow);
+            }
+            OSRAMImageDraw(pucRun, ulStart, ulRow, ulEnd - ulStart + 1, 1);
+            pxFb->ulBytesSent += ulEnd - ulStart + 1;
+
+            ulX = ulEnd + 1;
+        }
+    }
+
+    for (ulX = 0; ulX < fbWIDTH; ulX++)
+    {
+        if (prvIsDirty(pxFb, ulX))
+        {
+            pxFb->pusShown[ulX] = prvColumnAt(pxFb, ulX);
+        }
+    }
+    for (ulX = 0; ulX < sizeof(pxFb->pulDirty) / sizeof(pxFb->pulDirty[0]); ulX++)
+    {
+        pxFb->pulDirty[ulX] = 0;
+    }
+}
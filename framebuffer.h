@@ -0,0 +1,87 @@
+/*
+ * framebuffer.h
+ *
+ * Column framebuffer for the OSRAM 96x16 display of the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <stdint.h>
+
+#define fbWIDTH      96 // Columns of the display
+#define fbHEIGHT     16 // Scan lines of the display
+#define fbMERGE_GAP  6  // Clean columns sent anyway to join two dirty runs, cheaper than a new address
+
+/**
+ * @brief How the columns of the ring are placed on the display.
+ */
+typedef enum {
+    eFramebufferScroll, /**< The newest column is always at the left edge and the rest move right */
+    eFramebufferSweep   /**< Columns stay in place and a cursor sweeps the display, like an oscilloscope */
+} FramebufferMode_t;
+
+/**
+ * @brief Framebuffer with a ring of columns and a copy of what the display shows.
+ *
+ * New columns are written into the ring without moving the old ones.  The
+ * flush compares the columns marked dirty against the copy of the display and
+ * sends only the ones that changed, so the display is never cleared.
+ */
+typedef struct {
+    uint16_t pusColumns[fbWIDTH];     /**< Ring of columns, bit 0 is the top scan line */
+    uint16_t pusShown[fbWIDTH];       /**< Columns currently on the display, by screen position */
+    uint32_t pulDirty[(fbWIDTH + 31) / 32]; /**< Screen columns that may differ from pusShown */
+    uint8_t ucHead;                   /**< Ring index of the newest column */
+    FramebufferMode_t eMode;          /**< Placement of the ring on the display */
+    uint32_t ulBytesSent;             /**< Column bytes sent to the display since initialisation */
+} Framebuffer_t;
+
+/**
+ * @brief Initialises the framebuffer and clears the display once.
+ *
+ * OSRAMInit() must have been called before.
+ *
+ * @param pxFb Framebuffer to initialise.
+ * @param eMode Placement of the columns on the display.
+ */
+void vFramebufferInit(Framebuffer_t *pxFb, FramebufferMode_t eMode);
+
+/**
+ * @brief Returns the column mask of a single point.
+ *
+ * @param lValue Height of the point, 0 is the bottom scan line. Clamped to the display.
+ * @return uint16_t Column with only that point lit.
+ */
+uint16_t usFramebufferPoint(int32_t lValue);
+
+/**
+ * @brief Returns the column mask of a vertical segment between two heights.
+ *
+ * Used to draw the envelope of several samples in a single column.
+ *
+ * @param lLowest Lowest height of the segment, clamped to the display.
+ * @param lHighest Highest height of the segment, clamped to the display.
+ * @return uint16_t Column with every point between both heights lit.
+ */
+uint16_t usFramebufferRange(int32_t lLowest, int32_t lHighest);
+
+/**
+ * @brief Appends a column to the ring, in constant time.
+ *
+ * @param pxFb Framebuffer to update.
+ * @param usColumn Pixels of the column, bit 0 is the top scan line.
+ */
+void vFramebufferPushColumn(Framebuffer_t *pxFb, uint16_t usColumn);
+
+/**
+ * @brief Sends the columns that changed since the last flush to the display.
+ *
+ * @param pxFb Framebuffer to flush.
+ */
+void vFramebufferFlush(Framebuffer_t *pxFb);
+
+#endif /* FRAMEBUFFER_H */
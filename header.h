@@ -18,40 +18,228 @@
 #include "task.h"
 #include "queue.h"
 #include "semphr.h"
+#include "stream_buffer.h"
 #include "osram96x16.h"  
+#include "filter_chain.h"
+#include "framebuffer.h"
+#include "serial.h"
+#include "command.h"
+#include "prng.h"
+#include "workload.h"
+#include "pingpong.h"
+#include "taskstats.h"
+#include "taskprof.h"
+#include "telemetry.h"
+#include "latency.h"
+#include "stack_sizes.h"
 
 /* Configuration for the hardware and tasks. */
 #define mainBAUD_RATE                ( 19200 )
 #define MAX_HEIGHT 16  // Maximum graph height in pixels
 #define MAX_WIDTH 96   // Maximum graph width in pixels
+#define GRAPH_SWEEP 0 // Keeps the columns in place and sweeps a cursor across the display instead of scrolling the graph
+#define GRAPH_FRAME_RATE_HZ 0 // Refresh rate of the display, one column per frame with the envelope of its values. 0 draws every value as it arrives
 #define WATERMARK_MIN 0 // Shows the lowest historical free stack space value on the top function
-#define MAX_N 9 // Max number of N
+#define TOP_SORTED 1 // Lists the tasks from the busiest to the idlest over the last refresh window, across every page
+#define TOP_PAGE_TASKS 4 // Tasks read from the kernel at a time by the top task, bounds its stack use; sorted tables read the pages again when they do not fit in one
+#define TOP_TELEMETRY 0 // Sends the top statistics as binary frames for tools/telemetry_decode instead of a text table
+#define TOP_TELEMETRY_RATE_HZ 4 // Refresh rate of the top statistics in telemetry mode
+#define TOP_TELEMETRY_NAME_EVERY 8 // Statistics frames between two transmissions of the task names
+#define MAX_N 256 // Max number of N (length of the filter history)
 #define MIN_N 1 // Min number of N
+#define FILTER_SPEC_LEN 16 // Max length of a filter chain specification received by UART, e.g. "m5,b8,d2"
+#define MAX_SAMPLE_RATE_HZ 20000 // Max sample rate set with the rate command, the sensor task is limited to one sample per tick
+#define MIN_SAMPLE_RATE_HZ 1 // Min sample rate of the temperature sensor
+#define RAND_SEED 91218 // Initial seed of the simulated temperatures, the same seed always gives the same values
+
+/* Stack calibration, prints a stack_sizes.h measured on the running tasks with every refresh of the top task. */
+#define STACK_CALIBRATION 0 // Gives every task STACK_CALIBRATION_EXTRA more words than stack_sizes.h and prints the depths they need
+#define STACK_CALIBRATION_EXTRA 24 // Words added to every stack while calibrating, so a task that outgrew its stack can still be measured
+#define STACK_CALIBRATION_MARGIN_WORDS 10 // Words added to the measured use of every task, at least an exception frame
+#define STACK_CALIBRATION_MARGIN_PERCENT 10 // Share of the measured use added on top of STACK_CALIBRATION_MARGIN_WORDS
+
+/* Workload generator configuration, for load tests of the pipeline. */
+#define WORKLOAD_GENERATOR 0 // Produces the samples from a hardware timer interrupt instead of the temperature sensor task
+#define WORKLOAD_RATE_HZ 1000 // Initial rate of the timer interrupt, changed with the rate command
+#define WORKLOAD_SENSORS 1 // Virtual sensors sampled on every interrupt, their samples are interleaved
+#define WORKLOAD_WAVE eWaveNoise // Waveform of the sensors: eWaveNoise, eWaveRamp or eWaveSine
+#define WORKLOAD_BURST_PERIOD 0 // Interrupts between bursts, 0 disables them
+#define WORKLOAD_BURST_LENGTH 4 // Samples per sensor produced by a burst interrupt
+#define WORKLOAD_JITTER_PERCENT 0 // Max random deviation of every timer period
+
+/* Pipeline configuration. */
+#define PIPELINE_BATCH 1 // Moves samples between the tasks in blocks through stream buffers instead of one by one through queues
+#define PIPELINE_BATCH_SIZE 16 // Max number of samples handled per wakeup of the filter and graph tasks
+#define PIPELINE_BATCH_TRIGGER 1 // Samples that must be waiting in the stream before the filter task wakes up
+#define PIPELINE_STREAM_LENGTH 40 // Capacity of each stream buffer, in samples
+#define PIPELINE_PINGPONG 0 // The timer interrupt of the workload generator fills two alternating blocks and wakes the filter task once per full block
+#define PIPELINE_LATENCY 0 // Stamps every sample when it is created and shows in the top task how long it takes to reach the display
+
+#if PIPELINE_PINGPONG == 1 && (WORKLOAD_GENERATOR == 0 || PIPELINE_BATCH == 0)
+#error "PIPELINE_PINGPONG needs WORKLOAD_GENERATOR and PIPELINE_BATCH set to 1"
+#endif
+
+/* A sample moving through the pipeline, with the time it was created when PIPELINE_LATENCY is 1. */
+typedef struct {
+    int lValue;
+    #if PIPELINE_LATENCY == 1
+    uint32_t ulStamp; // Low 32 bits of the run time counter, wraps after more than 3 minutes
+    #endif
+} PipelineSample_t;
+
+#if PIPELINE_LATENCY == 1
+#define pipelineNOW()                ( ( uint32_t ) portGET_RUN_TIME_COUNTER_VALUE() )
+#endif
  
 /* Task priorities. */
 #define mainGRAPH_TASK_PRIORITY      ( tskIDLE_PRIORITY + 2 )
 #define mainTEMP_TASK_PRIORITY       ( tskIDLE_PRIORITY + 4 )
 #define mainFILTER_TASK_PRIORITY     ( tskIDLE_PRIORITY + 3 )
 #define mainTOP_TASK_PRIORITY        ( tskIDLE_PRIORITY + 1 )
+#define mainCOMMAND_TASK_PRIORITY    ( tskIDLE_PRIORITY + 2 )
+#if TOP_TELEMETRY == 1
+#define mainTOP_TASK_DELAY           ( pdMS_TO_TICKS(1000 / TOP_TELEMETRY_RATE_HZ) )
+#else
 #define mainTOP_TASK_DELAY           ( pdMS_TO_TICKS(5000) ) // 5 seconds
+#endif
+
+/* Stack depths of the tasks, in words. */
+#if STACK_CALIBRATION == 1
+#define mainSTACK(xWords)            ( (xWords) + STACK_CALIBRATION_EXTRA )
+#else
+#define mainSTACK(xWords)            ( xWords )
+#endif
+
+/* Run time statistics units, the counter runs at the core clock (timebase.c). */
+#define mainRUN_TIME_PER_MS          ( configCPU_CLOCK_HZ / 1000UL )
+#define mainRUN_TIME_PER_US          ( configCPU_CLOCK_HZ / 1000000UL )
+
+#define mainDATA_QUEUE_LENGTH        14 // Samples held by each data queue when PIPELINE_BATCH is 0
+
+/* Notification index of the single value channels (N and seed), which overwrite
+ * the pending value.  Index 0 is left to ulTaskNotifyTake(). */
+#define mainNOTIFY_MAILBOX           1
 
 
 /* Queue handles. */
 QueueHandle_t xFilteredQueue;
 QueueHandle_t xTemperatureQueue;
-QueueHandle_t xNQueue;
-QueueHandle_t xSeedQueue;
+QueueHandle_t xFilterSpecQueue;
+QueueHandle_t xRateQueue;
 
-volatile unsigned long ulHighFrequencyTimerTicks = 0;
+/* Stream buffer handles, used instead of the data queues when PIPELINE_BATCH is 1. */
+StreamBufferHandle_t xTemperatureStream;
+StreamBufferHandle_t xFilteredStream;
 
+/* Filter chain run by the filter task, its statistics are read by the top task. */
+FilterChain_t xFilterChain;
 
-/**
- * @brief Structure to store the lowest historical stack value of a task.
- */
+/* Framebuffer of the graph task, its traffic counter is read by the top task. */
+Framebuffer_t xFramebuffer;
+
+#if WORKLOAD_GENERATOR == 1
+/* Workload generator, advanced by the timer interrupt. */
+Workload_t xWorkload;
+#endif
+
+#if PIPELINE_PINGPONG == 1
+/* Blocks of samples handed from the timer interrupt to the filter task. */
+PingPong_t xPingPong;
+#endif
+
+#if PIPELINE_LATENCY == 1
+/* Time from the creation of the samples to the display, filled by the graph task and read by the top task. */
+LatencyStats_t xLatency;
+#endif
+
+#if STATIC_ALLOCATION == 1
+/* Memory of the tasks and queues of the static allocation build, placed by standalone.ld. */
+#define mainKERNEL_OBJECT            __attribute__((section(".kernel")))
+
+#if WORKLOAD_GENERATOR == 0
+static StaticTask_t xTempsTask mainKERNEL_OBJECT;
+static StackType_t puxTempsStack[mainSTACK(stackTEMPS_WORDS)] mainKERNEL_OBJECT;
+#endif
+static StaticTask_t xFilterTask mainKERNEL_OBJECT;
+static StackType_t puxFilterStack[mainSTACK(stackFILTER_WORDS)] mainKERNEL_OBJECT;
+static StaticTask_t xGraphTask mainKERNEL_OBJECT;
+static StackType_t puxGraphStack[mainSTACK(stackGRAPH_WORDS)] mainKERNEL_OBJECT;
+static StaticTask_t xTopTask mainKERNEL_OBJECT;
+static StackType_t puxTopStack[mainSTACK(stackTOP_WORDS)] mainKERNEL_OBJECT;
+static StaticTask_t xCommandTask mainKERNEL_OBJECT;
+static StackType_t puxCommandStack[mainSTACK(stackCOMMAND_WORDS)] mainKERNEL_OBJECT;
+static StaticTask_t xIdleTask mainKERNEL_OBJECT;
+static StackType_t puxIdleStack[configMINIMAL_STACK_SIZE] mainKERNEL_OBJECT;
+
+#if PIPELINE_BATCH == 1
+// A stream buffer keeps one byte of its storage empty
+#if PIPELINE_PINGPONG == 0
+static StaticStreamBuffer_t xTemperatureStreamBuffer mainKERNEL_OBJECT;
+static uint8_t pucTemperatureStreamStorage[PIPELINE_STREAM_LENGTH * sizeof(PipelineSample_t) + 1] mainKERNEL_OBJECT;
+#endif
+static StaticStreamBuffer_t xFilteredStreamBuffer mainKERNEL_OBJECT;
+static uint8_t pucFilteredStreamStorage[PIPELINE_STREAM_LENGTH * sizeof(PipelineSample_t) + 1] mainKERNEL_OBJECT;
+#else
+static StaticQueue_t xTemperatureQueueBuffer mainKERNEL_OBJECT;
+static uint8_t pucTemperatureQueueStorage[mainDATA_QUEUE_LENGTH * sizeof(PipelineSample_t)] mainKERNEL_OBJECT;
+static StaticQueue_t xFilteredQueueBuffer mainKERNEL_OBJECT;
+static uint8_t pucFilteredQueueStorage[mainDATA_QUEUE_LENGTH * sizeof(PipelineSample_t)] mainKERNEL_OBJECT;
+#endif
+static StaticQueue_t xFilterSpecQueueBuffer mainKERNEL_OBJECT;
+static uint8_t pucFilterSpecQueueStorage[FILTER_SPEC_LEN] mainKERNEL_OBJECT;
+#if WORKLOAD_GENERATOR == 0
+static StaticQueue_t xRateQueueBuffer mainKERNEL_OBJECT;
+static uint8_t pucRateQueueStorage[sizeof(int)] mainKERNEL_OBJECT;
+#endif
+
+/* Footprint of every kernel object, reported by the top task. */
 typedef struct {
-    TaskHandle_t xTaskHandle; /**< Handle of the task */
-    uint16_t usLowestStack;   /**< Lowest stack value recorded for the task */
-} TaskHistory_t;
+    const char *pcName; // Task or queue
+    uint16_t usBytes;   // Control block and stack or storage
+} KernelObject_t;
+
+static const KernelObject_t xKernelObjects[] = {
+    #if WORKLOAD_GENERATOR == 0
+    { "Temps", sizeof(xTempsTask) + sizeof(puxTempsStack) },
+    #endif
+    { "Filter", sizeof(xFilterTask) + sizeof(puxFilterStack) },
+    { "Graph", sizeof(xGraphTask) + sizeof(puxGraphStack) },
+    { "Top", sizeof(xTopTask) + sizeof(puxTopStack) },
+    { "Command", sizeof(xCommandTask) + sizeof(puxCommandStack) },
+    { "IDLE", sizeof(xIdleTask) + sizeof(puxIdleStack) },
+    #if PIPELINE_BATCH == 1
+    #if PIPELINE_PINGPONG == 0
+    { "Temp stream", sizeof(xTemperatureStreamBuffer) + sizeof(pucTemperatureStreamStorage) },
+    #endif
+    { "Filt stream", sizeof(xFilteredStreamBuffer) + sizeof(pucFilteredStreamStorage) },
+    #else
+    { "Temp queue", sizeof(xTemperatureQueueBuffer) + sizeof(pucTemperatureQueueStorage) },
+    { "Filt queue", sizeof(xFilteredQueueBuffer) + sizeof(pucFilteredQueueStorage) },
+    #endif
+    { "Spec queue", sizeof(xFilterSpecQueueBuffer) + sizeof(pucFilterSpecQueueStorage) },
+    #if WORKLOAD_GENERATOR == 0
+    { "Rate queue", sizeof(xRateQueueBuffer) + sizeof(pucRateQueueStorage) },
+    #endif
+};
+
+/* Bounds of the .kernel section, set by standalone.ld. */
+extern unsigned long _kernel;
+extern unsigned long _ekernel;
+#endif
+
+/* Tasks that receive the single value channels as notifications, see mainNOTIFY_MAILBOX. */
+TaskHandle_t xFilterTaskHandle; // New values of N
+
+/* Set by the command task after it sends N or a filter specification, so the
+ * filter task only calls the kernel to read them when one is pending. */
+volatile BaseType_t xFilterConfigPending = pdFALSE;
+#if WORKLOAD_GENERATOR == 0
+TaskHandle_t xTempsTaskHandle; // New seeds
+#endif
+
+/* Top task, paused and woken up by the command task. */
+TaskHandle_t xTopTaskHandle;
+volatile BaseType_t xTopPaused = pdFALSE;
 
 /*-----------------------------------------------------------*/
 
@@ -65,7 +253,9 @@ static void prvSetupHardware(void);
  * 
  * @param pvParameters Pointer to the parameters passed to the task (unused).
  */
+#if WORKLOAD_GENERATOR == 0
 static void vTemperatureSensorTask(void *pvParameters);
+#endif
 
 /**
  * @brief Task to apply a low-pass filter on the temperature values.
@@ -89,19 +279,21 @@ static void vGraphTask(void *pvParameters);
 static void vTopTask(void *pvParameters);
 
 /**
- * @brief Converts an integer value to a character array representing the graph.
- * 
- * @param graph Character array to store the graph data.
- * @param value The value to be converted into graph representation.
+ * @brief Task to read command lines from the UART and apply them.
+ *
+ * The characters are stored by the UART interrupt and parsed here, so the
+ * interrupt does not depend on the length of the commands.
+ *
+ * @param pvParameters Pointer to the parameters passed to the task (unused).
  */
-void intToGraph(unsigned char graph[2 * MAX_WIDTH], int value);
+static void vCommandTask(void *pvParameters);
 
 /**
  * @brief Sends a specified number of characters from a buffer over UART.
  *
- * This function sends `ulCount` characters from the buffer pointed to by `pucBuffer`
- * over the UART interface. It waits until the UART is ready to transmit before sending
- * each character.
+ * This function queues `ulCount` characters from the buffer pointed to by `pucBuffer`
+ * for the UART transmit interrupt and returns without waiting for them to be sent.
+ * It blocks only while the transmit ring is full.
  *
  * @param pucBuffer Pointer to the buffer containing the characters to send.
  * @param ulCount The number of characters to send from the buffer.
@@ -111,9 +303,8 @@ void UARTSend(const char *pucBuffer, unsigned long ulCount);
 /**
  * @brief Sends a null-terminated string over UART.
  *
- * This function sends each character of the null-terminated string pointed to by `str`
- * over the UART interface. It waits until the UART is ready to transmit before sending
- * each character.
+ * This function queues the null-terminated string pointed to by `str` for the UART
+ * transmit interrupt, like UARTSend().
  *
  * @param str Pointer to the null-terminated string to send.
  */
@@ -135,6 +326,43 @@ void my_itoa(int num, char *str);
  */
 size_t my_strlen(const char *str);
 
+/**
+ * @brief Sends one row of the table of the top task via UART, TOP_TELEMETRY must be 0.
+ *
+ * @param pxStatus Snapshot of the task.
+ * @param pxEntry Entry of the task in the statistics table, NULL if it has none.
+ * @param buffer Buffer of at least 112 characters for the row.
+ * @param temp Buffer of at least 12 characters for each column.
+ */
+void sendTaskRow(const TaskStatus_t *pxStatus, const TaskStatsEntry_t *pxEntry, char *buffer, char *temp);
+
+/**
+ * @brief Finds the task with a given rank in a page of tasks, TOP_SORTED must be 1.
+ *
+ * @param pxPage Page returned by uxTaskGetSystemStatePage().
+ * @param uxCount Number of tasks in the page.
+ * @param pxStats Statistics table of the current refresh.
+ * @param uxRank Rank from uxTaskStatsRank(), 0 is the busiest task.
+ * @return UBaseType_t Position of the task in the page, uxCount if it is not in it.
+ */
+UBaseType_t findRankedTask(const TaskStatus_t *pxPage, UBaseType_t uxCount, TaskStats_t *pxStats, UBaseType_t uxRank);
+
+/**
+ * @brief Converts tenths of a percent to a string with one decimal, e.g. 123 to "12.3".
+ *
+ * @param permille Value in tenths of a percent.
+ * @param str Pointer to the buffer to store the converted string.
+ */
+void formatPermille(uint32_t permille, char *str);
+
+/**
+ * @brief Sends the counts of a histogram via UART, separated by spaces.
+ *
+ * @param pusCounts Counts of the buckets.
+ * @param uxBuckets Number of buckets.
+ */
+void sendHistogram(const uint16_t *pusCounts, UBaseType_t uxBuckets);
+
 /**
  * @brief Copies characters from the source string to the destination string, padding the remaining space with spaces until the specified width is reached.
  *
@@ -158,21 +386,47 @@ tBoolean UARTBusy(unsigned long ulBase);
 void vUART_ISR(void);
 
 /**
- * @brief Timer interrupt handler.
+ * @brief Sends the statistics of the top task as binary telemetry frames, TOP_TELEMETRY must be 1.
+ *
+ * Called once per page of tasks, the decoder shows the table when the last page arrives.
+ *
+ * @param pxStatus Page returned by uxTaskGetSystemStatePage().
+ * @param pxEntries Entries of the statistics table for the tasks of the page, NULL for the untracked ones.
+ * @param uxCount Number of tasks in the page.
+ * @param uxFirst Position of the first task of the page in the whole snapshot.
+ * @param xLastPage pdTRUE for the last page of the refresh.
+ * @param pxStats Statistics table being refreshed.
+ * @param xSendNames pdTRUE to send the names of the tasks of the page too.
  */
-void Timer0IntHandler(void);
+void sendTelemetry(const TaskStatus_t *pxStatus, TaskStatsEntry_t * const *pxEntries, UBaseType_t uxCount, UBaseType_t uxFirst,
+                   BaseType_t xLastPage, const TaskStats_t *pxStats, BaseType_t xSendNames);
 
 /**
- * @brief Configures the timer for runtime statistics.
+ * @brief Sends the records of the trace recorder as binary frames for tools/trace_to_json, TRACE_RECORDER must be 1.
+ *
+ * Sends the clock of the timestamps, the names of the tasks and every record
+ * written since the previous call, then an empty trace frame.  The recorder is
+ * frozen meanwhile, so the events of the drain itself are dropped.
  */
-void configureTimerForRunTimeStats(void);
+void sendTrace(void);
 
 /**
- * @brief Retrieves the current runtime counter value.
- * 
- * @return uint32_t Current runtime counter value.
+ * @brief Prints a stack_sizes.h with the depth every task needs, STACK_CALIBRATION must be 1.
+ *
+ * The need of every task is its depth minus its high water mark, the least
+ * free space it ever had, plus the margins of the calibration settings.
  */
-uint32_t getRunTimeCounterValue(void);
+void sendStackHeader(void);
+
+/**
+ * @brief Configures the timer that drives the workload generator, WORKLOAD_GENERATOR must be 1.
+ */
+void configureTimerForWorkload(void);
+
+/**
+ * @brief Workload generator timer interrupt handler, hands the samples of a tick to the filter task.
+ */
+void Timer1IntHandler(void);
 
 /**
  * @brief Returns a string representation of the given task state.
@@ -191,14 +445,4 @@ uint32_t getRunTimeCounterValue(void);
  */
 const char* getTaskStateString(eTaskState state);
 
-/**
- * @brief Generates a pseudo-random number using a linear congruential generator (LCG).
- *
- * This function retrieves a seed from a queue, uses it to generate a new pseudo-random number,
- * updates the seed, and then places the updated seed back into the queue.
- *
- * @return The generated pseudo-random number.
- */
-unsigned int simple_rand(void);
-
 #endif /* CORTEX_LM3S811_H */
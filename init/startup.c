@@ -39,7 +39,6 @@ extern void xPortSysTickHandler(void);
 extern void vUART_ISR( void );
 extern void vGPIO_ISR( void );
 extern void vPortSVCHandler( void );
-extern void Timer0IntHandler( void);
 //*****************************************************************************
 //
 // The entry point for the application.
@@ -103,7 +102,7 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // ADC Sequence 2
     IntDefaultHandler,                      // ADC Sequence 3
     IntDefaultHandler,                      // Watchdog timer
-    Timer0IntHandler,                      // Timer 0 subtimer A
+    IntDefaultHandler,                      // Timer 0 subtimer A
     IntDefaultHandler,                      // Timer 0 subtimer B
     IntDefaultHandler,                      // Timer 1 subtimer A
     IntDefaultHandler,                      // Timer 1 subtimer B
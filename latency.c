@@ -0,0 +1,124 @@
+/*
+ * latency.c
+ *
+ * Latency histogram of the sample pipeline of the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#include "latency.h"
+
+#define latencySUB_MASK   ((1UL << latencySUB_BITS) - 1)
+
+/*-----------------------------------------------------------*/
+
+static uint32_t prvBucket(uint32_t ulMicroseconds)
+{
+    uint32_t ulLog2;
+
+    if (ulMicroseconds < (1UL << latencySUB_BITS))
+    {
+        return ulMicroseconds;
+    }
+
+    ulLog2 = 31 - __builtin_clz(ulMicroseconds);
+    if (ulLog2 > latencyMAX_LOG2)
+    {
+        return latencyBUCKETS - 1;
+    }
+
+    // Power of two first, then the bits right below the leading one
+    return ((ulLog2 - latencySUB_BITS + 1) << latencySUB_BITS) + ((ulMicroseconds >> (ulLog2 - latencySUB_BITS)) & latencySUB_MASK);
+}
+
+/* First latency above the bucket. */
+static uint32_t prvBucketLimit(uint32_t ulBucket)
+{
+    uint32_t ulShift;
+
+    if (ulBucket < (1UL << latencySUB_BITS))
+    {
+        return ulBucket + 1;
+    }
+
+    ulShift = (ulBucket >> latencySUB_BITS) - 1;
+    return (((1UL << latencySUB_BITS) + (ulBucket & latencySUB_MASK)) << ulShift) + (1UL << ulShift);
+}
+
+/*-----------------------------------------------------------*/
+
+void vLatencyReset(LatencyStats_t *pxStats)
+{
+    uint32_t x;
+
+    for (x = 0; x < latencyBUCKETS; x++)
+    {
+        pxStats->pusBuckets[x] = 0;
+    }
+    pxStats->ulCount = 0;
+    pxStats->ulMin = 0xFFFFFFFFUL;
+    pxStats->ulMax = 0;
+    pxStats->ullSum = 0;
+}
+
+void vLatencyAdd(LatencyStats_t *pxStats, uint32_t ulMicroseconds)
+{
+    uint16_t *pusBucket = &pxStats->pusBuckets[prvBucket(ulMicroseconds)];
+
+    if (*pusBucket < 0xFFFF)
+    {
+        (*pusBucket)++;
+    }
+    pxStats->ulCount++;
+    pxStats->ullSum += ulMicroseconds;
+    if (ulMicroseconds < pxStats->ulMin)
+    {
+        pxStats->ulMin = ulMicroseconds;
+    }
+    if (ulMicroseconds > pxStats->ulMax)
+    {
+        pxStats->ulMax = ulMicroseconds;
+    }
+}
+
+void vLatencyTake(LatencyStats_t *pxStats, LatencySummary_t *pxSummary)
+{
+    uint32_t ulTotal = 0, ulTarget, ulSeen = 0, x;
+
+    pxSummary->ulCount = pxStats->ulCount;
+    pxSummary->ulMin = 0;
+    pxSummary->ulAverage = 0;
+    pxSummary->ulP99 = 0;
+    pxSummary->ulMax = 0;
+
+    if (pxStats->ulCount > 0)
+    {
+        pxSummary->ulMin = pxStats->ulMin;
+        pxSummary->ulAverage = (uint32_t)(pxStats->ullSum / pxStats->ulCount);
+        pxSummary->ulMax = pxStats->ulMax;
+
+        // The rank comes from the buckets, which may have saturated, not from the count
+        for (x = 0; x < latencyBUCKETS; x++)
+        {
+            ulTotal += pxStats->pusBuckets[x];
+        }
+        ulTarget = ulTotal - ulTotal / 100; // Latencies at or below the percentile, rounded up
+        for (x = 0; x < latencyBUCKETS; x++)
+        {
+            ulSeen += pxStats->pusBuckets[x];
+            if (ulSeen >= ulTarget)
+            {
+                break;
+            }
+        }
+        // The last bucket has no upper edge
+        pxSummary->ulP99 = (x < latencyBUCKETS - 1) ? prvBucketLimit(x) - 1 : pxSummary->ulMax;
+        if (pxSummary->ulP99 > pxSummary->ulMax)
+        {
+            pxSummary->ulP99 = pxSummary->ulMax;
+        }
+    }
+
+    vLatencyReset(pxStats);
+}
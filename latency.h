@@ -0,0 +1,71 @@
+/*
+ * latency.h
+ *
+ * Latency histogram of the sample pipeline of the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <stdint.h>
+
+/*
+ * Latencies below 2^latencySUB_BITS us get a bucket each, every power of
+ * two above is split in 2^latencySUB_BITS buckets, so a percentile read
+ * from the histogram is never more than 25 % above the real one.
+ */
+#define latencySUB_BITS   2  // Buckets per power of two, as a power of two
+#define latencyMAX_LOG2   20 // Latencies of 2^(latencyMAX_LOG2 + 1) us, about 2 s, and more share the last bucket
+#define latencyBUCKETS    ((latencyMAX_LOG2 - latencySUB_BITS + 2) << latencySUB_BITS)
+
+/**
+ * @brief Latencies measured since the last call to vLatencyTake().
+ */
+typedef struct {
+    uint16_t pusBuckets[latencyBUCKETS]; /**< Latencies per bucket, saturating */
+    uint32_t ulCount;                    /**< Latencies measured */
+    uint32_t ulMin;                      /**< Lowest latency, in us */
+    uint32_t ulMax;                      /**< Highest latency, in us */
+    uint64_t ullSum;                     /**< Sum of the latencies, in us */
+} LatencyStats_t;
+
+/**
+ * @brief Summary of the latencies of a window.
+ */
+typedef struct {
+    uint32_t ulCount;   /**< Latencies measured, 0 leaves the other fields at 0 */
+    uint32_t ulMin;     /**< Lowest latency, in us */
+    uint32_t ulAverage; /**< Mean latency, in us */
+    uint32_t ulP99;     /**< 99th percentile, the upper edge of its bucket but never above ulMax */
+    uint32_t ulMax;     /**< Highest latency, in us */
+} LatencySummary_t;
+
+/**
+ * @brief Empties the histogram.
+ *
+ * @param pxStats Histogram to reset.
+ */
+void vLatencyReset(LatencyStats_t *pxStats);
+
+/**
+ * @brief Adds a latency to the histogram, in constant time.
+ *
+ * @param pxStats Histogram to update.
+ * @param ulMicroseconds Latency measured.
+ */
+void vLatencyAdd(LatencyStats_t *pxStats, uint32_t ulMicroseconds);
+
+/**
+ * @brief Summarises the histogram and empties it for the next window.
+ *
+ * The caller keeps vLatencyAdd() from running meanwhile.
+ *
+ * @param pxStats Histogram to read.
+ * @param pxSummary Receives the summary.
+ */
+void vLatencyTake(LatencyStats_t *pxStats, LatencySummary_t *pxSummary);
+
+#endif /* LATENCY_H */
@@ -13,18 +13,61 @@ int main(int argc, char *argv[])
     prvSetupHardware();
 
     /* Create the queues. */
-    xTemperatureQueue = xQueueCreate(10, sizeof(int));
-    xFilteredQueue = xQueueCreate(10, sizeof(int));
-    xNQueue = xQueueCreate(1, sizeof(int));  // Queue for sending N
-    xSeedQueue = xQueueCreate(1, sizeof(unsigned int));  // Queue for sending the seed
-    unsigned int seed = 91218; // Initialize the seed with an arbitrary value
-    xQueueSend(xSeedQueue, &seed, portMAX_DELAY);
+    #if STATIC_ALLOCATION == 1
+    #if PIPELINE_BATCH == 1
+    #if PIPELINE_PINGPONG == 0
+    xTemperatureStream = xStreamBufferCreateStatic(sizeof(pucTemperatureStreamStorage), PIPELINE_BATCH_TRIGGER * sizeof(PipelineSample_t),
+                                                   pucTemperatureStreamStorage, &xTemperatureStreamBuffer);
+    #endif
+    xFilteredStream = xStreamBufferCreateStatic(sizeof(pucFilteredStreamStorage), sizeof(PipelineSample_t), pucFilteredStreamStorage, &xFilteredStreamBuffer);
+    #else
+    xTemperatureQueue = xQueueCreateStatic(mainDATA_QUEUE_LENGTH, sizeof(PipelineSample_t), pucTemperatureQueueStorage, &xTemperatureQueueBuffer);
+    xFilteredQueue = xQueueCreateStatic(mainDATA_QUEUE_LENGTH, sizeof(PipelineSample_t), pucFilteredQueueStorage, &xFilteredQueueBuffer);
+    #endif
+    xFilterSpecQueue = xQueueCreateStatic(1, FILTER_SPEC_LEN, pucFilterSpecQueueStorage, &xFilterSpecQueueBuffer);
+    #if WORKLOAD_GENERATOR == 0
+    xRateQueue = xQueueCreateStatic(1, sizeof(int), pucRateQueueStorage, &xRateQueueBuffer);
+    #endif
+    #else
+    #if PIPELINE_BATCH == 1
+    #if PIPELINE_PINGPONG == 0
+    xTemperatureStream = xStreamBufferCreate(PIPELINE_STREAM_LENGTH * sizeof(PipelineSample_t), PIPELINE_BATCH_TRIGGER * sizeof(PipelineSample_t));
+    #endif
+    xFilteredStream = xStreamBufferCreate(PIPELINE_STREAM_LENGTH * sizeof(PipelineSample_t), sizeof(PipelineSample_t));
+    #else
+    xTemperatureQueue = xQueueCreate(mainDATA_QUEUE_LENGTH, sizeof(PipelineSample_t));
+    xFilteredQueue = xQueueCreate(mainDATA_QUEUE_LENGTH, sizeof(PipelineSample_t));
+    #endif
+    xFilterSpecQueue = xQueueCreate(1, FILTER_SPEC_LEN);  // Queue for sending the filter chain specification
+    #if WORKLOAD_GENERATOR == 0
+    xRateQueue = xQueueCreate(1, sizeof(int));  // Queue for sending the sample rate
+    #endif
+    #endif
 
     /* Start the tasks. */
-    xTaskCreate(vTemperatureSensorTask, "Temps", (configMINIMAL_STACK_SIZE)-48, NULL, mainTEMP_TASK_PRIORITY, NULL);
-    xTaskCreate(vFilterTask, "Filter", (configMINIMAL_STACK_SIZE)-42, NULL, mainFILTER_TASK_PRIORITY, NULL);
-    xTaskCreate(vGraphTask, "Graph", (configMINIMAL_STACK_SIZE)-2, NULL, mainGRAPH_TASK_PRIORITY, NULL);
-    xTaskCreate(vTopTask, "Top", (configMINIMAL_STACK_SIZE*2)-54, NULL, mainTOP_TASK_PRIORITY, NULL);   
+    #if WORKLOAD_GENERATOR == 1
+    configureTimerForWorkload();  // The samples come from the timer interrupt instead of a task
+    #endif
+    #if STATIC_ALLOCATION == 1
+    #if WORKLOAD_GENERATOR == 0
+    xTempsTaskHandle = xTaskCreateStatic(vTemperatureSensorTask, "Temps", mainSTACK(stackTEMPS_WORDS), NULL, mainTEMP_TASK_PRIORITY, puxTempsStack, &xTempsTask);
+    #endif
+    xFilterTaskHandle = xTaskCreateStatic(vFilterTask, "Filter", mainSTACK(stackFILTER_WORDS), NULL, mainFILTER_TASK_PRIORITY, puxFilterStack, &xFilterTask);
+    xTaskCreateStatic(vGraphTask, "Graph", mainSTACK(stackGRAPH_WORDS), NULL, mainGRAPH_TASK_PRIORITY, puxGraphStack, &xGraphTask);
+    xTopTaskHandle = xTaskCreateStatic(vTopTask, "Top", mainSTACK(stackTOP_WORDS), NULL, mainTOP_TASK_PRIORITY, puxTopStack, &xTopTask);
+    xTaskCreateStatic(vCommandTask, "Command", mainSTACK(stackCOMMAND_WORDS), NULL, mainCOMMAND_TASK_PRIORITY, puxCommandStack, &xCommandTask);
+    #else
+    #if WORKLOAD_GENERATOR == 0
+    xTaskCreate(vTemperatureSensorTask, "Temps", mainSTACK(stackTEMPS_WORDS), NULL, mainTEMP_TASK_PRIORITY, &xTempsTaskHandle);
+    #endif
+    xTaskCreate(vFilterTask, "Filter", mainSTACK(stackFILTER_WORDS), NULL, mainFILTER_TASK_PRIORITY, &xFilterTaskHandle);
+    xTaskCreate(vGraphTask, "Graph", mainSTACK(stackGRAPH_WORDS), NULL, mainGRAPH_TASK_PRIORITY, NULL);
+    xTaskCreate(vTopTask, "Top", mainSTACK(stackTOP_WORDS), NULL, mainTOP_TASK_PRIORITY, &xTopTaskHandle);
+    xTaskCreate(vCommandTask, "Command", mainSTACK(stackCOMMAND_WORDS), NULL, mainCOMMAND_TASK_PRIORITY, NULL);
+    #endif
+    #if PIPELINE_PINGPONG == 1
+    vPingPongInit(&xPingPong, xFilterTaskHandle);  // The timer interrupt wakes the filter task once per full block
+    #endif
 
     /* Start the scheduler. */
     vTaskStartScheduler();
@@ -38,8 +81,6 @@ static void prvSetupHardware(void)
     /* Setup the system clock. */
     SysCtlClockSet(SYSCTL_SYSDIV_10 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_6MHZ);
 
-    configureTimerForRunTimeStats();
-
     /* Enable the UART for communication. */
     SysCtlPeripheralEnable(SYSCTL_PERIPH_UART0);
     SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA);
@@ -52,6 +93,9 @@ static void prvSetupHardware(void)
     UARTIntEnable(UART0_BASE, UART_INT_RX | UART_INT_RT);
     IntEnable(INT_UART0);
     UARTIntRegister(UART0_BASE, vUART_ISR);  // Register the ISR
+
+    /* Transmit through a ring drained by the UART interrupt. */
+    vSerialInit();
 }
 
 
@@ -111,29 +155,27 @@ void my_itoa(int num, char *str) {
     }
 }
 
-void intToGraph(unsigned char graph[2*MAX_WIDTH], int value)
+void formatPermille(uint32_t permille, char *str)
 {
-    // Shift the graph buffer to the right to make space for the new value
-    for(int i = MAX_WIDTH - 1; i > 0; i--)
-    {
-        graph[i] = graph[i - 1]; // Shift the upper part of the graph
-        graph[i + MAX_WIDTH] = graph[i + MAX_WIDTH - 1]; // Shift the lower part of the graph
-    }
+    // Integer part, then the tenths
+    my_itoa(permille / 10, str);
+    str += my_strlen(str);
+    *str++ = '.';
+    *str++ = '0' + (permille % 10);
+    *str = '\0';
+}
 
-    // Clear the first column of the graph
-    graph[MAX_WIDTH] = 0; // Clear the upper part
-    graph[0] = 0; // Clear the lower part
+void sendHistogram(const uint16_t *pusCounts, UBaseType_t uxBuckets)
+{
+    char temp[8];
+    UBaseType_t x;
 
-    // Update the graph with the new value
-    if(value < 8)
+    // Counts separated by spaces, the buckets stay readable whatever their width
+    for (x = 0; x < uxBuckets; x++)
     {
-        // If the value is less than 8, update the upper part of the graph
-        graph[MAX_WIDTH] = (1 << (7 - value));
-    }
-    else
-    {
-        // If the value is 8 or greater, update the lower part of the graph
-        graph[0] = (1 << (15 - value));
+        my_itoa(pusCounts[x], temp);
+        UARTSendString(temp);
+        UARTSendString(" ");
     }
 }
 
@@ -156,45 +198,15 @@ void padString(char *dest, const char *src, int width)
     *dest = '\0';
 }
 
-unsigned int simple_rand(void)
-{
-    unsigned int seed;
-
-    // Receive the seed from the queue
-    if (xQueueReceive(xSeedQueue, &seed, portMAX_DELAY) == pdPASS)
-    {
-        // Generate the new seed value
-        seed = (seed * 1103515245 + 12345) & 0x7fffffff;
-
-        // Send the new seed back to the queue
-        xQueueSend(xSeedQueue, &seed, portMAX_DELAY);
-    }
-
-    return seed;
-}
-
 void UARTSend(const char *pucBuffer, unsigned long ulCount)
 {
-    while (ulCount--)
-    {
-        // Wait until the UART is ready to transmit
-        while (UARTBusy(UART0_BASE));
-        
-        // Send the character
-        UARTCharPut(UART0_BASE, *pucBuffer++);
-    }
+    // Queued for the UART interrupt, blocks only while the transmit ring is full
+    vSerialWrite(pucBuffer, ulCount);
 }
 
 void UARTSendString(const char *str)
 {
-    while (*str)
-    {
-        // Wait until the UART is ready to transmit
-        while (UARTBusy(UART0_BASE));
-        
-        // Send the character
-        UARTCharPut(UART0_BASE, *str++);
-    }
+    vSerialWrite(str, my_strlen(str));
 }
 
 const char* getTaskStateString(eTaskState state)
@@ -210,145 +222,458 @@ const char* getTaskStateString(eTaskState state)
     }
 }
 
+#if TOP_TELEMETRY == 0
+void sendTaskRow(const TaskStatus_t *pxStatus, const TaskStatsEntry_t *pxEntry, char *buffer, char *temp)
+{
+    // Format the task name
+    padString(buffer, pxStatus->pcTaskName, 15);
+
+    // Format the task state
+    padString(buffer + 15, getTaskStateString(pxStatus->eCurrentState), 13);
+
+    // Format the task priority
+    my_itoa(pxStatus->uxCurrentPriority, temp);
+    padString(buffer + 28, temp, 12);
+
+    // Format the task stack
+    my_itoa(pxStatus->usStackHighWaterMark, temp);
+    padString(buffer + 40, temp, 14);
+
+    // Format the lowest historical stack value, kept by the statistics table
+    #if WATERMARK_MIN == 1
+    if (pxEntry != NULL)
+    {
+        my_itoa(pxEntry->usMinStack, temp);
+    }
+    else
+    {
+        temp[0] = '-';
+        temp[1] = '\0';
+    }
+    padString(buffer + 54, temp, 14);
+    #endif
+
+    // Format the task number
+    #if WATERMARK_MIN == 1
+    my_itoa(pxStatus->xTaskNumber, temp);
+    padString(buffer + 68, temp, 16);
+    #else
+    my_itoa(pxStatus->xTaskNumber, temp);
+    padString(buffer + 54, temp, 12);
+    #endif
+
+    // Format the task CPU time
+    #if WATERMARK_MIN == 1
+    my_itoa(pxStatus->ulRunTimeCounter / mainRUN_TIME_PER_MS, temp);
+    padString(buffer + 84, temp, 17);
+    #else
+    my_itoa(pxStatus->ulRunTimeCounter / mainRUN_TIME_PER_MS, temp);
+    padString(buffer + 66, temp, 15);
+    #endif
+
+    // Format the share of the CPU used since the previous table
+    if (pxEntry != NULL)
+    {
+        formatPermille(ulTaskStatsPermille(pxEntry), temp);
+    }
+    else
+    {
+        temp[0] = '-';
+        temp[1] = '\0';
+    }
+    #if WATERMARK_MIN == 1
+    padString(buffer + 101, temp, 8);
+    #else
+    padString(buffer + 81, temp, 8);
+    #endif
+
+    // End the string with "\r\n"
+    #if WATERMARK_MIN == 1
+    buffer[109] = '\r';
+    buffer[110] = '\n';
+    buffer[111] = '\0';
+    #else
+    buffer[89] = '\r';
+    buffer[90] = '\n';
+    buffer[91] = '\0';
+    #endif
+
+    // Send the formatted line via UART
+    UARTSendString(buffer);
+}
+
+#if TOP_SORTED == 1
+UBaseType_t findRankedTask(const TaskStatus_t *pxPage, UBaseType_t uxCount, TaskStats_t *pxStats, UBaseType_t uxRank)
+{
+    TaskStatsEntry_t *pxEntry;
+    UBaseType_t x;
+
+    for (x = 0; x < uxCount; x++)
+    {
+        pxEntry = pxTaskStatsFind(pxStats, pxPage[x].xTaskNumber);
+        if (pxEntry != NULL && uxTaskStatsRank(pxStats, pxEntry) == uxRank)
+        {
+            break;
+        }
+    }
+
+    return x;
+}
+#endif
+#endif
+
 static void vTopTask(void *pvParameters)
 {
+    static TaskStats_t xTaskStats; // Kept from one refresh to the next, out of the task stack
+    TaskStatus_t pxPage[TOP_PAGE_TASKS]; // One page of the snapshot, the stack use does not grow with the number of tasks
+    #if TOP_TELEMETRY == 1 || TOP_SORTED == 0
+    TaskStatsEntry_t *pxEntries[TOP_PAGE_TASKS];
+    #endif
+    UBaseType_t uxFirst, uxPage, x;
+    configRUN_TIME_COUNTER_TYPE ulTotalRunTime;
+    TickType_t xLastWakeTime;
+    TickType_t xElapsed;
+    BaseType_t xDumpRequested = pdFALSE;
+    #if TOP_TELEMETRY == 1
+    UBaseType_t uxRefreshes = 0;
+    #else
     char buffer[128];
     char temp[32];
-    UBaseType_t uxArraySize, x;
-    uxArraySize = uxTaskGetNumberOfTasks();
-    TaskStatus_t pxTaskStatusArray[uxArraySize]; 
-    uint32_t ulTotalRunTime;
+    #if TOP_SORTED == 1
+    UBaseType_t uxRank;
+    #endif
+    #if STATIC_ALLOCATION == 0
     size_t xFreeHeapSize;
-    TickType_t xLastWakeTime;
-
-    #if WATERMARK_MIN == 1
-    TaskHistory_t xTaskHistoryArray[uxArraySize];
     #endif
+    FilterType_t eStageType;
+    uint16_t usStageParam;
+    uint32_t ulStageCycles;
+    #if TASK_PROFILE == 1
+    TaskProfStats_t xProfile;
+    #endif
+    #if PIPELINE_LATENCY == 1
+    static LatencySummary_t xLatencySummary; // Kept out of the task stack
+    #endif
+    #endif
+
     xLastWakeTime = xTaskGetTickCount();
+    vTaskStatsInit(&xTaskStats);
 
     for (;;)
     {
-        // Initialize the task history array if WATERMARK_MIN is defined as 1
-        #if WATERMARK_MIN == 1
-        for (x = 0; x < uxArraySize; x++) {
-            xTaskHistoryArray[x].xTaskHandle = NULL;
-            xTaskHistoryArray[x].usLowestStack = 0xFFFF; // Initial high value
+        // Wait until the next update, or until the stats command asks for the table right away
+        xElapsed = xTaskGetTickCount() - xLastWakeTime;
+        if (ulTaskNotifyTake(pdTRUE, (xElapsed < mainTOP_TASK_DELAY) ? (mainTOP_TASK_DELAY - xElapsed) : 0) > 0)
+        {
+            xDumpRequested = pdTRUE;
+        }
+        else
+        {
+            xLastWakeTime += mainTOP_TASK_DELAY;
         }
-        #endif
 
-        // Get the state of all tasks
-        uxArraySize = uxTaskGetSystemState(pxTaskStatusArray, uxArraySize, &ulTotalRunTime);
+        // The pause command stops the periodic table, not the requested ones
+        if (xTopPaused == pdTRUE && xDumpRequested == pdFALSE)
+        {
+            continue;
+        }
+        xDumpRequested = pdFALSE;
 
+        // The idle share comes from the counter of the idle task, so it is known before any page
+        vTaskStatsBeginRefresh(&xTaskStats, portGET_RUN_TIME_COUNTER_VALUE(), ulTaskGetIdleRunTimeCounter());
+
+        #if TOP_TELEMETRY == 0
         // Send header via UART depending on the value of WATERMARK_MIN
         #if WATERMARK_MIN == 1
-        UARTSendString("Task Name      State        Priority   Stack(Words)  Stack-Min(words)  Task Number      TimeOfCpu(ms)\r\n");
+        UARTSendString("Task Name      State        Priority   Stack(Words)  Stack-Min(words)  Task Number      TimeOfCpu(ms)    CPU(%)\r\n");
         #else
-        UARTSendString("Task Name      State        Priority   Stack(Words)  Task Number  TimeOfCpu(ms)\r\n");
+        UARTSendString("Task Name      State        Priority   Stack(Words)  Task Number  TimeOfCpu(ms)  CPU(%)\r\n");
+        #endif
         #endif
 
-        // Iterate through all tasks and send their statistics via UART
-        for (x = 0; x < uxArraySize; x++)
+        // Go through the tasks one page at a time, a short page is the last one
+        uxFirst = 0;
+        do
         {
-            // Format the task name
-            padString(buffer, pxTaskStatusArray[x].pcTaskName, 15);
+            uxPage = uxTaskGetSystemStatePage(pxPage, TOP_PAGE_TASKS, uxFirst, &ulTotalRunTime);
 
-            // Format the task state
-            padString(buffer + 15, getTaskStateString(pxTaskStatusArray[x].eCurrentState), 13);
+            // Get the run time of every task since its previous update
+            for (x = 0; x < uxPage; x++)
+            {
+                #if TOP_TELEMETRY == 1 || TOP_SORTED == 0
+                pxEntries[x] = pxTaskStatsUpdate(&xTaskStats, &pxPage[x], ulTotalRunTime);
+                #else
+                (void)pxTaskStatsUpdate(&xTaskStats, &pxPage[x], ulTotalRunTime); // Printed once every page is in the table
+                #endif
+            }
 
-            // Format the task priority
-            my_itoa(pxTaskStatusArray[x].uxCurrentPriority, temp);
-            padString(buffer + 28, temp, 12);
+            #if TOP_TELEMETRY == 1
+            // Send the statistics as binary frames, decoded on the host
+            sendTelemetry(pxPage, pxEntries, uxPage, uxFirst, uxPage < TOP_PAGE_TASKS, &xTaskStats,
+                          uxRefreshes % TOP_TELEMETRY_NAME_EVERY == 0);
+            #elif TOP_SORTED == 0
+            // Send the statistics of the tasks of the page via UART, in the order of the kernel
+            for (x = 0; x < uxPage; x++)
+            {
+                sendTaskRow(&pxPage[x], pxEntries[x], buffer, temp);
+            }
+            #endif
 
-            // Format the task stack
-            my_itoa(pxTaskStatusArray[x].usStackHighWaterMark, temp);
-            padString(buffer + 40, temp, 14);
+            uxFirst += uxPage;
+        } while (uxPage == TOP_PAGE_TASKS);
 
-            // Update and format the lowest historical stack value if WATERMARK_MIN is defined as 1
-            #if WATERMARK_MIN == 1
-            for (int i = 0; i < uxArraySize; i++) {
-                if (xTaskHistoryArray[i].xTaskHandle == pxTaskStatusArray[x].xHandle || xTaskHistoryArray[i].xTaskHandle == NULL) {
-                    if (xTaskHistoryArray[i].xTaskHandle == NULL) {
-                        xTaskHistoryArray[i].xTaskHandle = pxTaskStatusArray[x].xHandle;
-                    }
-                    if (pxTaskStatusArray[x].usStackHighWaterMark < xTaskHistoryArray[i].usLowestStack) {
-                        xTaskHistoryArray[i].usLowestStack = pxTaskStatusArray[x].usStackHighWaterMark;
-                    }
-                    my_itoa(xTaskHistoryArray[i].usLowestStack, temp);
-                    padString(buffer + 54, temp, 14);
-                    break;
-                }
+        #if TOP_TELEMETRY == 0 && TOP_SORTED == 1
+        // Busiest tasks first across every page; the last page read is searched first, so a snapshot that fits in one page is read once
+        for (uxRank = 0; uxRank < xTaskStats.uxUpdated; uxRank++)
+        {
+            x = findRankedTask(pxPage, uxPage, &xTaskStats, uxRank);
+
+            // Read the pages again until the task shows up, it is skipped if it was deleted meanwhile
+            for (uxFirst = 0; x == uxPage && (uxFirst == 0 || uxPage == TOP_PAGE_TASKS); uxFirst += uxPage)
+            {
+                uxPage = uxTaskGetSystemStatePage(pxPage, TOP_PAGE_TASKS, uxFirst, NULL);
+                x = findRankedTask(pxPage, uxPage, &xTaskStats, uxRank);
             }
-            #endif
 
-            // Format the task number
-            #if WATERMARK_MIN == 1
-            my_itoa(pxTaskStatusArray[x].xTaskNumber, temp);
-            padString(buffer + 68, temp, 16);
-            #else
-            my_itoa(pxTaskStatusArray[x].xTaskNumber, temp);
-            padString(buffer + 54, temp, 12);
-            #endif
+            if (x < uxPage)
+            {
+                sendTaskRow(&pxPage[x], pxTaskStatsFind(&xTaskStats, pxPage[x].xTaskNumber), buffer, temp);
+            }
+        }
 
-            // Format the task CPU time
-            #if WATERMARK_MIN == 1
-            my_itoa(pxTaskStatusArray[x].ulRunTimeCounter, temp);
-            padString(buffer + 84, temp, 17);
-            #else
-            my_itoa(pxTaskStatusArray[x].ulRunTimeCounter, temp);
-            padString(buffer + 66, temp, 15);
-            #endif
+        // Tasks without statistics last, in the order of the kernel
+        if (xTaskStats.uxUntracked > 0)
+        {
+            uxFirst = 0;
+            do
+            {
+                uxPage = uxTaskGetSystemStatePage(pxPage, TOP_PAGE_TASKS, uxFirst, NULL);
+                for (x = 0; x < uxPage; x++)
+                {
+                    if (pxTaskStatsFind(&xTaskStats, pxPage[x].xTaskNumber) == NULL)
+                    {
+                        sendTaskRow(&pxPage[x], NULL, buffer, temp);
+                    }
+                }
+                uxFirst += uxPage;
+            } while (uxPage == TOP_PAGE_TASKS);
+        }
+        #endif
 
-            // End the string with "\r\n"
-            #if WATERMARK_MIN == 1
-            buffer[101] = '\r';
-            buffer[102] = '\n';
-            buffer[103] = '\0';
-            #else
-            buffer[81] = '\r';
-            buffer[82] = '\n';
-            buffer[83] = '\0';
-            #endif
+        // Free the entries of the tasks deleted since the previous refreshes
+        vTaskStatsEndRefresh(&xTaskStats);
 
-            // Send the formatted line via UART
-            UARTSendString(buffer);
+        #if TOP_TELEMETRY == 1
+        uxRefreshes++;
+        #else
+        // Tasks past the capacity of the statistics table are listed without CPU share
+        if (xTaskStats.uxUntracked > 0)
+        {
+            UARTSendString("Tasks without statistics: ");
+            my_itoa(xTaskStats.uxUntracked, temp);
+            UARTSendString(temp);
+            UARTSendString("\r\n");
         }
 
         // Send the total run time
         UARTSendString("Total Run Time: ");
-        my_itoa(ulTotalRunTime, temp);
+        my_itoa(ulTotalRunTime / mainRUN_TIME_PER_MS, temp);
         UARTSendString(temp);
         UARTSendString(" ms\r\n");
 
+        // Send the share of the last window spent in the idle task
+        UARTSendString("Idle: ");
+        formatPermille(xTaskStats.ulIdlePermille, temp);
+        UARTSendString(temp);
+        UARTSendString(" %\r\n");
+
+        #if STATIC_ALLOCATION == 1
+        // There is no heap, send the memory of every kernel object instead
+        UARTSendString("Object      Bytes\r\n");
+        for (i = 0; i < sizeof(xKernelObjects) / sizeof(xKernelObjects[0]); i++)
+        {
+            padString(buffer, xKernelObjects[i].pcName, 12);
+            UARTSendString(buffer);
+            my_itoa(xKernelObjects[i].usBytes, temp);
+            UARTSendString(temp);
+            UARTSendString("\r\n");
+        }
+        UARTSendString("Kernel objects: ");
+        my_itoa((char *)&_ekernel - (char *)&_kernel, temp);
+        UARTSendString(temp);
+        UARTSendString(" bytes\r\n");
+        #else
         // Get and send the free heap size
         xFreeHeapSize = xPortGetFreeHeapSize();
         UARTSendString("Free heap: ");
         my_itoa(xFreeHeapSize, temp);
         UARTSendString(temp);
         UARTSendString(" bytes\r\n");
+        #endif
+
+        // Send the amount of graph data sent to the display
+        UARTSendString("Display traffic: ");
+        my_itoa(xFramebuffer.ulBytesSent, temp);
+        UARTSendString(temp);
+        UARTSendString(" bytes\r\n");
+
+        #if PIPELINE_LATENCY == 1
+        // Send the time the samples took from their creation to the display since the last update
+        vTaskSuspendAll(); // The graph task adds to the histogram
+        vLatencyTake(&xLatency, &xLatencySummary);
+        xTaskResumeAll();
+        UARTSendString("Latency (us): min ");
+        my_itoa(xLatencySummary.ulMin, temp);
+        UARTSendString(temp);
+        UARTSendString(" avg ");
+        my_itoa(xLatencySummary.ulAverage, temp);
+        UARTSendString(temp);
+        UARTSendString(" p99 ");
+        my_itoa(xLatencySummary.ulP99, temp);
+        UARTSendString(temp);
+        UARTSendString(" max ");
+        my_itoa(xLatencySummary.ulMax, temp);
+        UARTSendString(temp);
+        UARTSendString(", ");
+        my_itoa(xLatencySummary.ulCount, temp);
+        UARTSendString(temp);
+        UARTSendString(" values\r\n");
+        #endif
+
+        #if WORKLOAD_GENERATOR == 1
+        // Send the number of generated samples and the ones the pipeline could not take
+        UARTSendString("Workload: ");
+        my_itoa(xWorkload.ulGenerated, temp);
+        UARTSendString(temp);
+        UARTSendString(" samples, ");
+        my_itoa(xWorkload.ulDropped, temp);
+        UARTSendString(temp);
+        UARTSendString(" dropped\r\n");
+        #endif
+
+        // Send the number of received characters lost because the command task fell behind
+        UARTSendString("UART RX dropped: ");
+        my_itoa(ulSerialRxDropped(), temp);
+        UARTSendString(temp);
+        UARTSendString(" chars\r\n");
 
-        // Wait before the next update
-        vTaskDelayUntil(&xLastWakeTime, mainTOP_TASK_DELAY);
+        // Send the cost of every stage of the filter chain since the last update
+        UARTSendString("Filter Stage   Param        Cycles/Sample\r\n");
+        for (x = 0; xFilterChainGetStageStats(&xFilterChain, x, &eStageType, &usStageParam, &ulStageCycles) == pdTRUE; x++)
+        {
+            padString(buffer, pcFilterTypeName(eStageType), 15);
+            my_itoa(usStageParam, temp);
+            padString(buffer + 15, temp, 13);
+            my_itoa(ulStageCycles, temp);
+            padString(buffer + 28, temp, 13);
+            buffer[41] = '\r';
+            buffer[42] = '\n';
+            buffer[43] = '\0';
+            UARTSendString(buffer);
+        }
+
+        #if TASK_PROFILE == 1
+        // Send the switches of every task and the histograms of its slices and blocked times since the last update
+        UARTSendString("Histogram buckets (us):");
+        for (x = 0; x < taskprofBUCKETS - 1; x++)
+        {
+            UARTSendString(" <");
+            my_itoa(ulTaskProfBucketLimitUs(x), temp);
+            UARTSendString(temp);
+        }
+        UARTSendString(" more\r\n");
+        UARTSendString("Task Name      Vol      Invol    Slices / Blocked\r\n");
+        uxFirst = 0;
+        do
+        {
+            uxPage = uxTaskGetSystemStatePage(pxPage, TOP_PAGE_TASKS, uxFirst, NULL);
+            for (x = 0; x < uxPage; x++)
+            {
+                if (xTaskProfGet(pxPage[x].xHandle, &xProfile, pdTRUE) == pdFALSE)
+                {
+                    continue;
+                }
+                padString(buffer, pxPage[x].pcTaskName, 15);
+                my_itoa(xProfile.ulVoluntary, temp);
+                padString(buffer + 15, temp, 9);
+                my_itoa(xProfile.ulInvoluntary, temp);
+                padString(buffer + 24, temp, 9);
+                buffer[33] = '\0';
+                UARTSendString(buffer);
+                sendHistogram(xProfile.pusSlice, taskprofBUCKETS);
+                UARTSendString("/");
+                sendHistogram(xProfile.pusBlocked, taskprofBUCKETS);
+                UARTSendString("\r\n");
+            }
+            uxFirst += uxPage;
+        } while (uxPage == TOP_PAGE_TASKS);
+        #endif
+        #endif
+
+        #if STACK_CALIBRATION == 1
+        // The high water marks only go down, every header is closer to the worst case than the previous one
+        sendStackHeader();
+        #endif
     }
 }
 
+#if WORKLOAD_GENERATOR == 0
 static void vTemperatureSensorTask(void *pvParameters)
 {
-    const TickType_t xFrequency = pdMS_TO_TICKS(100); // 10Hz frequency
+    static int32_t temperatures[PIPELINE_BATCH_SIZE]; // Block of simulated values, kept out of the task stack
+    size_t xNext = PIPELINE_BATCH_SIZE;
+    Prng_t xPrng; // Owned by this task, so drawing numbers needs no kernel call
+    TickType_t xFrequency = pdMS_TO_TICKS(100); // 10Hz frequency
     TickType_t xLastWakeTime = xTaskGetTickCount();
+    uint32_t seed;
+    int rate;
+
+    vPrngSeed(&xPrng, RAND_SEED);
 
     for(;;)
     {
-        int temperature = simple_rand() % 100;  // Simulate temperature between 0 and 99 degrees
+        if (xNext == PIPELINE_BATCH_SIZE)
+        {
+            /* A new seed restarts the sequence from the next block */
+            if (xTaskNotifyWaitIndexed(mainNOTIFY_MAILBOX, 0, 0, &seed, 0) == pdTRUE)
+            {
+                vPrngSeed(&xPrng, seed);
+            }
+
+            /* Simulate a whole block of temperatures between 0 and 99 degrees at once */
+            vPrngFillRange(&xPrng, temperatures, PIPELINE_BATCH_SIZE, 100);
+            xNext = 0;
+        }
+
+        /* Check if a new sample rate has been received */
+        if (xQueueReceive(xRateQueue, &rate, 0) == pdPASS)
+        {
+            xFrequency = pdMS_TO_TICKS(1000 / rate);
+            if (xFrequency == 0)
+            {
+                xFrequency = 1;
+            }
+        }
+
+        PipelineSample_t temperature;
+        temperature.lValue = temperatures[xNext++];
+        #if PIPELINE_LATENCY == 1
+        temperature.ulStamp = pipelineNOW();
+        #endif
+        #if PIPELINE_BATCH == 1
+        xStreamBufferSend(xTemperatureStream, &temperature, sizeof(temperature), portMAX_DELAY);
+        #else
         xQueueSend(xTemperatureQueue, &temperature, portMAX_DELAY);
+        #endif
         vTaskDelayUntil(&xLastWakeTime, xFrequency);
     }
 }
+#endif
 
 void vUART_ISR(void)
 {
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
     uint32_t ulStatus;
-    char c;
-    int newN;
 
     /* Get the interrupt status. */
     ulStatus = UARTIntStatus(UART0_BASE, true);
@@ -356,125 +681,633 @@ void vUART_ISR(void)
     /* Clear the asserted interrupts. */
     UARTIntClear(UART0_BASE, ulStatus);
 
-    /* Check if it's a receive interrupt. */
+    /* Refill the transmit FIFO from the ring. */
+    if (ulStatus & UART_INT_TX)
+    {
+        vSerialTxISR(&xHigherPriorityTaskWoken);
+    }
+
+    /* Only store the received characters, they are parsed by the command task. */
     if (ulStatus & (UART_INT_RX | UART_INT_RT))
     {
-        /* Get the character from UART. */
-        c = UARTCharGet(UART0_BASE);
+        vSerialRxISR(&xHigherPriorityTaskWoken);
+    }
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+static void vCommandTask(void *pvParameters)
+{
+    static CommandLine_t xLine; // Kept out of the task stack
+    Command_t xCommand;
+    char pcEcho[4];
+    char c;
+    int value;
+    unsigned int seed;
+    BaseType_t xComplete;
 
-        /* Check if the character is a valid number between '1' and '9'. */
-        if (c >= '1' && c <= '9')
+    vCommandLineReset(&xLine);
+
+    for (;;)
+    {
+        /* Wait for a character stored by the UART interrupt. */
+        if (xSerialGetChar(&c, portMAX_DELAY) != pdPASS)
         {
-            newN = c - '0'; // Convert ASCII to integer
+            continue;
+        }
 
-            /* Send the new value of N to the filter task via the queue. */
-            xQueueSendFromISR(xNQueue, &newN, NULL);
+        /* Echo the character from the task, not from the interrupt. */
+        xComplete = xCommandLineAddChar(&xLine, c, pcEcho);
+        UARTSendString(pcEcho);
+        if (xComplete == pdFALSE)
+        {
+            continue;
+        }
 
-            UARTCharPut(UART0_BASE, c);
+        vCommandParse(&xLine, &xCommand);
+        value = xCommand.lValue;
 
-            /* Exit the ISR to free the UART. */
-            return;
+        switch (xCommand.eType)
+        {
+            case eCommandNone:
+                break;
+
+            case eCommandSetN:
+                if (value < MIN_N || value > MAX_N)
+                {
+                    xCommand.eType = eCommandInvalid;
+                    break;
+                }
+                // Overwrites a value the filter task has not taken yet, the command never blocks
+                xTaskNotifyIndexed(xFilterTaskHandle, mainNOTIFY_MAILBOX, value, eSetValueWithOverwrite);
+                xFilterConfigPending = pdTRUE; // Set after the value is sent, so the filter task finds it
+                break;
+
+            case eCommandSeed:
+                seed = value;
+                #if WORKLOAD_GENERATOR == 1
+                taskENTER_CRITICAL();
+                vPrngSeed(&xWorkload.xPrng, seed);
+                taskEXIT_CRITICAL();
+                #else
+                xTaskNotifyIndexed(xTempsTaskHandle, mainNOTIFY_MAILBOX, seed, eSetValueWithOverwrite);
+                #endif
+                break;
+
+            case eCommandSetRate:
+                if (value < MIN_SAMPLE_RATE_HZ || value > MAX_SAMPLE_RATE_HZ)
+                {
+                    xCommand.eType = eCommandInvalid;
+                    break;
+                }
+                #if WORKLOAD_GENERATOR == 1
+                xWorkload.ulPeriod = SysCtlClockGet() / value; // Applied by the timer interrupt from its next period
+                #else
+                xQueueOverwrite(xRateQueue, &value); // Replaces a rate the sensor task has not taken yet, the command never blocks
+                #endif
+                break;
+
+            case eCommandSetFilter:
+                /* The specification is checked by the filter task, an invalid one is ignored. */
+                if (my_strlen(xCommand.pcText) >= FILTER_SPEC_LEN)
+                {
+                    xCommand.eType = eCommandInvalid;
+                    break;
+                }
+                xQueueSend(xFilterSpecQueue, xCommand.pcText, portMAX_DELAY);
+                xFilterConfigPending = pdTRUE;
+                break;
+
+            case eCommandPauseTop:
+                xTopPaused = pdTRUE;
+                break;
+
+            case eCommandResumeTop:
+                xTopPaused = pdFALSE;
+                break;
+
+            case eCommandStats:
+                xTaskNotifyGive(xTopTaskHandle);
+                break;
+
+            case eCommandTrace:
+                #if TRACE_RECORDER == 1
+                sendTrace();
+                #else
+                xCommand.eType = eCommandInvalid;
+                #endif
+                break;
+
+            case eCommandHelp:
+                UARTSendString("n <N>  rate <Hz>  seed <S>  filter <spec>  pause  resume  stats  trace\r\n");
+                break;
+
+            default:
+                break;
         }
-        else
+
+        if (xCommand.eType == eCommandInvalid)
         {
-            UARTCharPut(UART0_BASE, 'E'); // Echo 'E' for error
+            UARTSendString("E\r\n"); // Echo 'E' for error
         }
+        else if (xCommand.eType != eCommandNone)
+        {
+            UARTSendString("OK\r\n");
+        }
+        vCommandLineReset(&xLine);
     }
 }
 
 static void vFilterTask(void *pvParameters)
 {
-    int N = 3; // Initial value of N
-    int buffer[MAX_N] = {0}; // Static buffer of fixed size
-    int sum = 0;
-    int receivedN = 3;
-    int temperature = 0;
-    int count = 0; // Variable that allows calculating the average even when the number of samples is less than N.
+    static MovAvgSample_t psHistory[MAX_N]; // Sample history of the boxcar stages, kept out of the task stack
+    char pcSpec[FILTER_SPEC_LEN];
+    uint32_t receivedN;
+    int32_t filteredValue;
+    #if PIPELINE_PINGPONG == 1
+    const int32_t *samples; // Read in place from the ping-pong buffer
+    static PipelineSample_t filteredValues[pingpongBLOCK_SIZE]; // Kept out of the task stack
+    #elif PIPELINE_BATCH == 1
+    static PipelineSample_t samples[PIPELINE_BATCH_SIZE]; // Block buffers, kept out of the task stack
+    static PipelineSample_t filteredValues[PIPELINE_BATCH_SIZE];
+    #endif
+
+    vFilterChainInit(&xFilterChain, psHistory, MAX_N, 3); // A single boxcar with the initial value of N, 3
 
     for (;;)
     {
-        /* Check if a new value for N has been received */
-        if (xQueueReceive(xNQueue, &receivedN, 0) == pdPASS)
+        /* Only call the kernel when the command task has sent something. The flag is
+         * cleared before reading, so a value sent in between is read now or on the next pass. */
+        if (xFilterConfigPending == pdTRUE)
         {
-            /* Adjust the value of N */
-            N = receivedN;
+            xFilterConfigPending = pdFALSE;
+
+            /* Check if a new value for N has been received */
+            if (xTaskNotifyWaitIndexed(mainNOTIFY_MAILBOX, 0, 0, &receivedN, 0) == pdTRUE)
+            {
+                /* Adjust the value of N */
+                vFilterChainSetWindow(&xFilterChain, receivedN);
+            }
+
+            /* Check if a new filter chain has been requested */
+            if (xQueueReceive(xFilterSpecQueue, pcSpec, 0) == pdPASS)
+            {
+                /* An invalid specification leaves the current chain untouched */
+                xFilterChainConfigure(&xFilterChain, pcSpec);
+            }
         }
 
-        if (xQueueReceive(xTemperatureQueue, &temperature, portMAX_DELAY) == pdPASS)
+        #if PIPELINE_BATCH == 1
+        #if PIPELINE_PINGPONG == 1
+        /* Wait for the timer interrupt to hand over a full block, the only wakeup per block. */
+        samples = plPingPongTake(&xPingPong, portMAX_DELAY);
+        size_t xReceived = (samples != NULL) ? pingpongBLOCK_SIZE : 0;
+        #else
+        /* Take every sample waiting in the stream, up to a full block, in a single call. */
+        size_t xReceived = xStreamBufferReceive(xTemperatureStream, samples, sizeof(samples), portMAX_DELAY) / sizeof(PipelineSample_t);
+        #endif
+        size_t xFiltered = 0;
+
+        for (size_t i = 0; i < xReceived; i++)
         {
-            for (int i = MAX_N - 1; i > 0; i--)
+            #if PIPELINE_PINGPONG == 1
+            PipelineSample_t sample;
+            sample.lValue = samples[i];
+            #if PIPELINE_LATENCY == 1
+            sample.ulStamp = ulPingPongStamp(&xPingPong); // The whole block is as old as its first sample
+            #endif
+            #else
+            PipelineSample_t sample = samples[i];
+            #endif
+
+            /* A decimating stage may absorb the sample, an output keeps the stamp of the sample that completed it. */
+            if (xFilterChainProcess(&xFilterChain, sample.lValue, &filteredValue) == pdTRUE)
             {
-                buffer[i] = buffer[i - 1];
+                sample.lValue = filteredValue;
+                filteredValues[xFiltered++] = sample;
             }
-            buffer[0] = temperature;
-            if (count < MAX_N) count++;
-            sum = 0; // Reset sum before adding the values from the buffer
-            int valuesToAverage = (count < N) ? count : N;
-            for (int i = 0; i < valuesToAverage; i++)
+        }
+
+        #if PIPELINE_PINGPONG == 1
+        /* The samples have been used, the interrupt may fill the block again. */
+        if (samples != NULL)
+        {
+            vPingPongRelease(&xPingPong);
+        }
+        #endif
+
+        /* Publish the whole block of filtered values at once. */
+        if (xFiltered > 0)
+        {
+            xStreamBufferSend(xFilteredStream, filteredValues, xFiltered * sizeof(PipelineSample_t), portMAX_DELAY);
+        }
+        #else
+        PipelineSample_t sample;
+
+        if (xQueueReceive(xTemperatureQueue, &sample, portMAX_DELAY) == pdPASS)
+        {
+            /* A decimating stage may absorb the sample, an output keeps the stamp of the sample that completed it. */
+            if (xFilterChainProcess(&xFilterChain, sample.lValue, &filteredValue) == pdTRUE)
             {
-                sum += buffer[i];
+                sample.lValue = filteredValue;
+                xQueueSend(xFilteredQueue, &sample, portMAX_DELAY);
             }
-            int filteredValue = sum / valuesToAverage;
-            xQueueSend(xFilteredQueue, &filteredValue, portMAX_DELAY);
         }
+        #endif
     }
 }
 
 static void vGraphTask(void *pvParameters)
 {
-    int filteredValue;
-    unsigned char graph[2 * MAX_WIDTH] = {0}; // Buffer to store the graph on the two lines of the screen
+    #if PIPELINE_BATCH == 1
+    static PipelineSample_t filteredValues[PIPELINE_BATCH_SIZE]; // Block buffer, kept out of the task stack
+    #else
+    PipelineSample_t filteredValues[1];
+    #endif
+    size_t xReceived;
+    #if PIPELINE_LATENCY == 1
+    uint32_t ulNow;
+    #endif
+    TickType_t xWait = portMAX_DELAY;
+    #if GRAPH_FRAME_RATE_HZ > 0
+    const TickType_t xFramePeriod = pdMS_TO_TICKS(1000 / GRAPH_FRAME_RATE_HZ);
+    TickType_t xLastFrame = xTaskGetTickCount();
+    TickType_t xElapsed;
+    int lowest = MAX_HEIGHT; // Envelope of the values received during the current frame
+    int highest = -1;
+    #if PIPELINE_LATENCY == 1
+    uint32_t ulColumnStamp = 0; // Stamp of the oldest value of the column being built
+    #endif
+    #endif
 
-    // Initialize the LCD screen
+    // Initialize the LCD screen, it is cleared only once by the framebuffer
     OSRAMInit(false);
-    OSRAMClear();
+    vFramebufferInit(&xFramebuffer, (GRAPH_SWEEP == 1) ? eFramebufferSweep : eFramebufferScroll);
+    #if PIPELINE_LATENCY == 1
+    vLatencyReset(&xLatency);
+    #endif
 
     for (;;)
     {
+        #if GRAPH_FRAME_RATE_HZ > 0
+        /* Wait for values only until the next frame is due. */
+        xElapsed = xTaskGetTickCount() - xLastFrame;
+        xWait = (xElapsed < xFramePeriod) ? (xFramePeriod - xElapsed) : 0;
+        #endif
+
+        #if PIPELINE_BATCH == 1
+        /* Wait for a block of filtered values to arrive. */
+        xReceived = xStreamBufferReceive(xFilteredStream, filteredValues, sizeof(filteredValues), xWait) / sizeof(PipelineSample_t);
+        #else
         /* Wait for a filtered value to arrive. */
-        xQueueReceive(xFilteredQueue, &filteredValue, portMAX_DELAY);
-    
-        /* Scale the filtered value to the height of the graph. */
-        int scaledValue = (filteredValue * (MAX_HEIGHT)) / 99;        
-        /* Call the intToGraph function to update the graph buffer. */
-        intToGraph(graph, scaledValue);
-        /* Clear the LCD screen before drawing the graph */
-        OSRAMClear();
-        /* Draw the graph on the LCD screen. */
-        OSRAMImageDraw(graph, 0, 0, MAX_WIDTH, 2);
+        xReceived = (xQueueReceive(xFilteredQueue, &filteredValues[0], xWait) == pdPASS) ? 1 : 0;
+        #endif
+
+        for (size_t i = 0; i < xReceived; i++)
+        {
+            /* Scale the filtered value to the height of the graph. */
+            int scaledValue = (filteredValues[i].lValue * (MAX_HEIGHT)) / 99;
+
+            #if GRAPH_FRAME_RATE_HZ > 0
+            #if PIPELINE_LATENCY == 1
+            /* The values arrive in order, the first one of the column is the oldest. */
+            if (highest < 0) ulColumnStamp = filteredValues[i].ulStamp;
+            #endif
+            /* Keep the envelope so that no value of the frame is lost on screen. */
+            if (scaledValue < lowest) lowest = scaledValue;
+            if (scaledValue > highest) highest = scaledValue;
+            #else
+            /* Add the value to the graph as a new column. */
+            vFramebufferPushColumn(&xFramebuffer, usFramebufferPoint(scaledValue));
+            #endif
+        }
+
+        #if GRAPH_FRAME_RATE_HZ > 0
+        if (xTaskGetTickCount() - xLastFrame < xFramePeriod)
+        {
+            continue;
+        }
+
+        /* One column per frame, spanning every value received during it. */
+        if (highest >= 0)
+        {
+            vFramebufferPushColumn(&xFramebuffer, usFramebufferRange(lowest, highest));
+            lowest = MAX_HEIGHT;
+            highest = -1;
+            vFramebufferFlush(&xFramebuffer); // Nothing changes on the display in a frame without values
+
+            #if PIPELINE_LATENCY == 1
+            /* A column counts once, with its oldest value, which waited the most. */
+            ulNow = pipelineNOW();
+            vLatencyAdd(&xLatency, (ulNow - ulColumnStamp) / mainRUN_TIME_PER_US);
+            #endif
+        }
+
+        /* Skip the frames that could not be drawn instead of trying to catch up. */
+        xLastFrame += xFramePeriod;
+        if (xTaskGetTickCount() - xLastFrame >= xFramePeriod)
+        {
+            xLastFrame = xTaskGetTickCount();
+        }
+        #else
+        if (xReceived > 0)
+        {
+            /* Send only the columns that changed to the LCD screen. */
+            vFramebufferFlush(&xFramebuffer);
+
+            #if PIPELINE_LATENCY == 1
+            /* Every value of the block is on the display now. */
+            ulNow = pipelineNOW();
+            for (size_t i = 0; i < xReceived; i++)
+            {
+                vLatencyAdd(&xLatency, (ulNow - filteredValues[i].ulStamp) / mainRUN_TIME_PER_US);
+            }
+            #endif
+        }
+        #endif
     }
 }
 
-void configureTimerForRunTimeStats(void)
+#if TOP_TELEMETRY == 1
+void sendTelemetry(const TaskStatus_t *pxStatus, TaskStatsEntry_t * const *pxEntries, UBaseType_t uxCount, UBaseType_t uxFirst,
+                   BaseType_t xLastPage, const TaskStats_t *pxStats, BaseType_t xSendNames)
 {
-    // Enable the timer peripheral
-    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER0);
-    TimerConfigure(TIMER0_BASE, TIMER_CFG_32_BIT_TIMER);
+    static TelemetryFrame_t xFrame; // Kept out of the task stack
+    UBaseType_t x, uxSent, uxRecords;
+    uint32_t ulDelta, ulWindow;
+
+    // Names are sent again from time to time, so a decoder started later learns them
+    if (xSendNames == pdTRUE)
+    {
+        for (x = 0; x < uxCount; x++)
+        {
+            vTelemetryBegin(&xFrame, telemetryTYPE_NAME);
+            vTelemetryPut8(&xFrame, pxStatus[x].xTaskNumber);
+            vTelemetryPutString(&xFrame, pxStatus[x].pcTaskName);
+            UARTSend((const char *)xFrame.pucData, usTelemetryEnd(&xFrame));
+        }
+    }
 
-    // Configure the timer to generate interrupts every 1 ms
-    uint32_t ui32Period = (SysCtlClockGet()/1000);
-    TimerLoadSet(TIMER0_BASE, TIMER_A, ui32Period - 1);
+    // The frames carry microseconds, 32 bits hold a window of more than an hour
+    ulWindow = (pxStats->ulWindow / mainRUN_TIME_PER_US > 0xFFFFFFFFUL) ? 0xFFFFFFFFUL : (uint32_t)(pxStats->ulWindow / mainRUN_TIME_PER_US);
 
-    // Register the interrupt handler
-    TimerIntRegister(TIMER0_BASE, TIMER_A, Timer0IntHandler);
-    IntEnable(INT_TIMER0A);
-    TimerIntEnable(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
+    // As many frames as needed to carry the page
+    uxSent = 0;
+    do
+    {
+        uxRecords = uxCount - uxSent;
+        if (uxRecords > (telemetryMAX_PAYLOAD - telemetrySTATS_HEADER) / telemetrySTATS_RECORD)
+        {
+            uxRecords = (telemetryMAX_PAYLOAD - telemetrySTATS_HEADER) / telemetrySTATS_RECORD;
+        }
 
-    // Enable the timer
-    TimerEnable(TIMER0_BASE, TIMER_A);
+        vTelemetryBegin(&xFrame, telemetryTYPE_STATS);
+        vTelemetryPut32(&xFrame, pxStats->ulTotalRunTime / mainRUN_TIME_PER_MS);
+        vTelemetryPut32(&xFrame, ulWindow);
+        #if STATIC_ALLOCATION == 1
+        vTelemetryPut32(&xFrame, 0); // No heap
+        #else
+        vTelemetryPut32(&xFrame, xPortGetFreeHeapSize());
+        #endif
+        vTelemetryPut16(&xFrame, pxStats->ulIdlePermille);
+        // Until the last frame of the set the count is one past this frame, so the decoder keeps waiting
+        vTelemetryPut8(&xFrame, uxFirst + uxSent + uxRecords + ((xLastPage == pdTRUE && uxSent + uxRecords == uxCount) ? 0 : 1));
+        vTelemetryPut8(&xFrame, uxFirst + uxSent);
+
+        for (x = uxSent; x < uxSent + uxRecords; x++)
+        {
+            vTelemetryPut8(&xFrame, pxStatus[x].xTaskNumber);
+            vTelemetryPut8(&xFrame, pxStatus[x].eCurrentState);
+            vTelemetryPut8(&xFrame, pxStatus[x].uxCurrentPriority);
+            vTelemetryPut16(&xFrame, pxStatus[x].usStackHighWaterMark);
+
+            // Tasks past the capacity of the table have no window, all ones marks it unknown
+            ulDelta = 0xFFFFFFFFUL;
+            if (pxEntries[x] != NULL)
+            {
+                // Share of its own window applied to the window of the frame, the task may have a longer one if a refresh missed it
+                ulDelta = 0;
+                if (pxEntries[x]->ulWindow != 0)
+                {
+                    ulDelta = (uint32_t)(((uint64_t)pxEntries[x]->ulDelta * ulWindow) / pxEntries[x]->ulWindow);
+                }
+            }
+            vTelemetryPut32(&xFrame, ulDelta);
+        }
+
+        UARTSend((const char *)xFrame.pucData, usTelemetryEnd(&xFrame));
+        uxSent += uxRecords;
+    } while (uxSent < uxCount);
 }
+#endif
 
-void Timer0IntHandler(void)
+#if TRACE_RECORDER == 1
+void sendTrace(void)
 {
-    // Clear the timer interrupt
-    TimerIntClear(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
+    static TelemetryFrame_t xFrame; // Kept out of the task stack
+    static TaskStatus_t xStatus;
+    static uint32_t pulRecords[(telemetryMAX_PAYLOAD - telemetryTRACE_HEADER) / 4];
+    UBaseType_t uxTask;
+    uint32_t ulLost;
+    size_t xCount, x;
+
+    // Nothing is recorded while the ring is read, the sends below would fill it with the drain itself
+    vRecorderFreeze(1);
+
+    vTelemetryBegin(&xFrame, telemetryTYPE_TRACE_INFO);
+    vTelemetryPut32(&xFrame, configCPU_CLOCK_HZ);
+    vTelemetryPut8(&xFrame, recorderTIME_SHIFT);
+    UARTSend((const char *)xFrame.pucData, usTelemetryEnd(&xFrame));
+
+    // One task at a time, the names are only needed to label the timeline
+    for (uxTask = 0; uxTaskGetSystemStatePage(&xStatus, 1, uxTask, NULL) == 1; uxTask++)
+    {
+        vTelemetryBegin(&xFrame, telemetryTYPE_NAME);
+        vTelemetryPut8(&xFrame, xStatus.xTaskNumber);
+        vTelemetryPutString(&xFrame, xStatus.pcTaskName);
+        UARTSend((const char *)xFrame.pucData, usTelemetryEnd(&xFrame));
+    }
+
+    // The last frame is the one without records
+    do
+    {
+        xCount = xRecorderRead(pulRecords, sizeof(pulRecords) / sizeof(pulRecords[0]), &ulLost);
+
+        vTelemetryBegin(&xFrame, telemetryTYPE_TRACE);
+        vTelemetryPut32(&xFrame, ulLost);
+        for (x = 0; x < xCount; x++)
+        {
+            vTelemetryPut32(&xFrame, pulRecords[x]);
+        }
+        UARTSend((const char *)xFrame.pucData, usTelemetryEnd(&xFrame));
+    } while (xCount > 0);
+
+    vRecorderFreeze(0);
+}
+#endif
+
+#if STACK_CALIBRATION == 1
+void sendStackHeader(void)
+{
+    static const struct {
+        const char *pcTask;  // Name given to xTaskCreate()
+        const char *pcMacro; // Macro of stack_sizes.h
+        uint16_t usWords;    // Depth in the current stack_sizes.h
+    } xStacks[] = {
+        { "Temps", "stackTEMPS_WORDS", stackTEMPS_WORDS },
+        { "Filter", "stackFILTER_WORDS", stackFILTER_WORDS },
+        { "Graph", "stackGRAPH_WORDS", stackGRAPH_WORDS },
+        { "Top", "stackTOP_WORDS", stackTOP_WORDS },
+        { "Command", "stackCOMMAND_WORDS", stackCOMMAND_WORDS }
+    };
+    char buffer[32];
+    char temp[12];
+    TaskHandle_t xTask;
+    UBaseType_t x, uxUsed, uxWords;
+    int lSaved = 0;
+
+    UARTSendString("/*\r\n * stack_sizes.h\r\n *\r\n * Stack depths of the tasks of the cortex_LM3S811 program, in words.\r\n *\r\n"
+                   " * Generated by STACK_CALIBRATION after ");
+    my_itoa(xTaskGetTickCount() / configTICK_RATE_HZ, temp);
+    UARTSendString(temp);
+    UARTSendString(" s.\r\n *\r\n * FreeRTOS V202212.01\r\n"
+                   " * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.\r\n */\r\n\r\n"
+                   "#ifndef STACK_SIZES_H\r\n#define STACK_SIZES_H\r\n\r\n");
+
+    for (x = 0; x < sizeof(xStacks) / sizeof(xStacks[0]); x++)
+    {
+        padString(buffer, "#define ", 8);
+        padString(buffer + 8, xStacks[x].pcMacro, 21);
+        UARTSendString(buffer);
+
+        // A task that is not part of this build keeps its depth
+        xTask = xTaskGetHandle(xStacks[x].pcTask);
+        if (xTask == NULL)
+        {
+            my_itoa(xStacks[x].usWords, temp);
+            UARTSendString(temp);
+            UARTSendString(" // Not running, kept\r\n");
+            continue;
+        }
+
+        // The high water mark is the least free space the task ever had
+        uxUsed = mainSTACK(xStacks[x].usWords) - uxTaskGetStackHighWaterMark(xTask);
+        uxWords = uxUsed + (uxUsed * STACK_CALIBRATION_MARGIN_PERCENT + 99) / 100 + STACK_CALIBRATION_MARGIN_WORDS;
+        lSaved += ((int)xStacks[x].usWords - (int)uxWords) * (int)sizeof(StackType_t);
+
+        my_itoa(uxWords, temp);
+        padString(buffer, temp, 5);
+        UARTSendString(buffer);
+        UARTSendString("// Used ");
+        my_itoa(uxUsed, temp);
+        UARTSendString(temp);
+        UARTSendString("\r\n");
+    }
+
+    // The idle task takes configMINIMAL_STACK_SIZE, shown for reference
+    UARTSendString("\r\n/* Idle task used ");
+    my_itoa(configMINIMAL_STACK_SIZE - uxTaskGetStackHighWaterMark(xTaskGetIdleTaskHandle()), temp);
+    UARTSendString(temp);
+    UARTSendString(" of configMINIMAL_STACK_SIZE words, these depths free ");
+    my_itoa(lSaved, temp);
+    UARTSendString(temp);
+    UARTSendString(" bytes of RAM. */\r\n\r\n#endif /* STACK_SIZES_H */\r\n");
+}
+#endif
+
+#if STATIC_ALLOCATION == 1
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize)
+{
+    // With no heap the kernel takes the idle task memory from the application
+    *ppxIdleTaskTCBBuffer = &xIdleTask;
+    *ppxIdleTaskStackBuffer = puxIdleStack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+#endif
+
+#if WORKLOAD_GENERATOR == 1
+void configureTimerForWorkload(void)
+{
+    vWorkloadInit(&xWorkload, WORKLOAD_SENSORS, WORKLOAD_WAVE, SysCtlClockGet() / WORKLOAD_RATE_HZ, RAND_SEED);
+    vWorkloadSetBurst(&xWorkload, WORKLOAD_BURST_PERIOD, WORKLOAD_BURST_LENGTH);
+    vWorkloadSetJitter(&xWorkload, WORKLOAD_JITTER_PERCENT);
+
+    // Enable the timer peripheral as a periodic timer
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER1);
+    TimerConfigure(TIMER1_BASE, TIMER_CFG_32_BIT_PER);
+    TimerLoadSet(TIMER1_BASE, TIMER_A, xWorkload.ulPeriod - 1);
 
-    // Increment the runtime counter
-    ulHighFrequencyTimerTicks++;
+    // Register the interrupt handler, at a priority allowed to call the FromISR functions
+    TimerIntRegister(TIMER1_BASE, TIMER_A, Timer1IntHandler);
+    IntPrioritySet(INT_TIMER1A, configKERNEL_INTERRUPT_PRIORITY);
+    IntEnable(INT_TIMER1A);
+    TimerIntEnable(TIMER1_BASE, TIMER_TIMA_TIMEOUT);
+
+    // Enable the timer
+    TimerEnable(TIMER1_BASE, TIMER_A);
 }
 
-uint32_t getRunTimeCounterValue(void)
+void Timer1IntHandler(void)
 {
-    // Return the current runtime counter value
-    return ulHighFrequencyTimerTicks;
+    static int32_t samples[workloadMAX_SAMPLES_PER_TICK]; // Kept off the small interrupt stack
+    #if PIPELINE_LATENCY == 1 && PIPELINE_PINGPONG == 0
+    #if PIPELINE_BATCH == 1
+    static PipelineSample_t pxStamped[workloadMAX_SAMPLES_PER_TICK]; // Stamped copies in the layout of the stream
+    #endif
+    uint32_t ulStamp;
+    #endif
+    static uint32_t ulLoadedPeriod = 0;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    UBaseType_t uxCount;
+    uint32_t ulPeriod;
+
+    // Clear the timer interrupt
+    TimerIntClear(TIMER1_BASE, TIMER_TIMA_TIMEOUT);
+
+    // Reload the timer only when the period changes, reloading restarts the count
+    ulPeriod = ulWorkloadNextPeriod(&xWorkload);
+    if (ulPeriod != ulLoadedPeriod)
+    {
+        TimerLoadSet(TIMER1_BASE, TIMER_A, ulPeriod - 1);
+        ulLoadedPeriod = ulPeriod;
+    }
+
+    // Hand the samples to the filter task, counting the ones that do not fit
+    uxCount = uxWorkloadTick(&xWorkload, samples);
+    #if PIPELINE_LATENCY == 1 && PIPELINE_PINGPONG == 0
+    ulStamp = pipelineNOW(); // Every sample of the interrupt is created now
+    #endif
+    #if PIPELINE_PINGPONG == 1
+    #if PIPELINE_LATENCY == 1
+    xWorkload.ulDropped += uxCount - uxPingPongWriteFromISR(&xPingPong, samples, uxCount, pipelineNOW(), &xHigherPriorityTaskWoken);
+    #else
+    xWorkload.ulDropped += uxCount - uxPingPongWriteFromISR(&xPingPong, samples, uxCount, 0, &xHigherPriorityTaskWoken);
+    #endif
+    #elif PIPELINE_BATCH == 1 && PIPELINE_LATENCY == 1
+    for (UBaseType_t x = 0; x < uxCount; x++)
+    {
+        pxStamped[x].lValue = samples[x];
+        pxStamped[x].ulStamp = ulStamp;
+    }
+    xWorkload.ulDropped += uxCount - (xStreamBufferSendFromISR(xTemperatureStream, pxStamped, uxCount * sizeof(PipelineSample_t), &xHigherPriorityTaskWoken) / sizeof(PipelineSample_t));
+    #elif PIPELINE_BATCH == 1
+    // Without a stamp a sample of the stream is just its value
+    xWorkload.ulDropped += uxCount - (xStreamBufferSendFromISR(xTemperatureStream, samples, uxCount * sizeof(int32_t), &xHigherPriorityTaskWoken) / sizeof(int32_t));
+    #else
+    for (UBaseType_t x = 0; x < uxCount; x++)
+    {
+        PipelineSample_t xSample;
+        xSample.lValue = samples[x];
+        #if PIPELINE_LATENCY == 1
+        xSample.ulStamp = ulStamp;
+        #endif
+        if (xQueueSendFromISR(xTemperatureQueue, &xSample, &xHigherPriorityTaskWoken) != pdPASS)
+        {
+            xWorkload.ulDropped++;
+        }
+    }
+    #endif
+
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
+#endif
@@ -0,0 +1,138 @@
+/*
+ * movavg.c
+ *
+ * Fixed-point moving-average filter for the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#include "movavg.h"
+
+/*-----------------------------------------------------------*/
+
+/* Returns the k-th newest sample of the history (k = 1 is the newest one). */
+static MovAvgSample_t prvNewestSample(const MovingAverage_t *pxFilter, uint16_t usAge)
+{
+    uint32_t ulIndex = (uint32_t)pxFilter->usHead + pxFilter->usCapacity - usAge;
+
+    if (ulIndex >= pxFilter->usCapacity)
+    {
+        ulIndex -= pxFilter->usCapacity;
+    }
+
+    return pxFilter->psBuffer[ulIndex];
+}
+
+/* Number of samples currently contributing to the sum. */
+static uint16_t prvSamplesInWindow(const MovingAverage_t *pxFilter)
+{
+    return (pxFilter->usCount < pxFilter->usWindow) ? pxFilter->usCount : pxFilter->usWindow;
+}
+
+/* Divides rounding to the nearest integer, half away from zero. */
+static int32_t prvDivideRounded(int32_t lValue, uint16_t usDivisor)
+{
+    if (lValue >= 0)
+    {
+        return (lValue + (usDivisor / 2)) / usDivisor;
+    }
+
+    return -((-lValue + (usDivisor / 2)) / usDivisor);
+}
+
+static uint16_t prvClampWindow(const MovingAverage_t *pxFilter, uint16_t usWindow)
+{
+    if (usWindow < 1)
+    {
+        return 1;
+    }
+    if (usWindow > pxFilter->usCapacity)
+    {
+        return pxFilter->usCapacity;
+    }
+    return usWindow;
+}
+
+/*-----------------------------------------------------------*/
+
+void vMovingAverageInit(MovingAverage_t *pxFilter, MovAvgSample_t *psBuffer, uint16_t usCapacity, uint16_t usWindow)
+{
+    pxFilter->psBuffer = psBuffer;
+    pxFilter->usCapacity = (usCapacity > 0) ? usCapacity : 1;
+    pxFilter->usWindow = prvClampWindow(pxFilter, usWindow);
+    vMovingAverageReset(pxFilter);
+}
+
+void vMovingAverageReset(MovingAverage_t *pxFilter)
+{
+    pxFilter->usHead = 0;
+    pxFilter->usCount = 0;
+    pxFilter->lSum = 0;
+}
+
+void vMovingAverageSetWindow(MovingAverage_t *pxFilter, uint16_t usWindow)
+{
+    uint16_t usOldInWindow = prvSamplesInWindow(pxFilter);
+    uint16_t usNewInWindow;
+    uint16_t usAge;
+
+    pxFilter->usWindow = prvClampWindow(pxFilter, usWindow);
+    usNewInWindow = prvSamplesInWindow(pxFilter);
+
+    // Only the samples between the old and the new window edge change the sum
+    if (usNewInWindow < usOldInWindow)
+    {
+        for (usAge = usNewInWindow + 1; usAge <= usOldInWindow; usAge++)
+        {
+            pxFilter->lSum -= prvNewestSample(pxFilter, usAge);
+        }
+    }
+    else
+    {
+        for (usAge = usOldInWindow + 1; usAge <= usNewInWindow; usAge++)
+        {
+            pxFilter->lSum += prvNewestSample(pxFilter, usAge);
+        }
+    }
+}
+
+int32_t lMovingAverageAdd(MovingAverage_t *pxFilter, MovAvgSample_t sSample)
+{
+    // The sample leaving the window must be read before it can be overwritten
+    if (pxFilter->usCount >= pxFilter->usWindow)
+    {
+        pxFilter->lSum -= prvNewestSample(pxFilter, pxFilter->usWindow);
+    }
+
+    pxFilter->psBuffer[pxFilter->usHead] = sSample;
+    pxFilter->lSum += sSample;
+
+    if (++pxFilter->usHead == pxFilter->usCapacity)
+    {
+        pxFilter->usHead = 0;
+    }
+    if (pxFilter->usCount < pxFilter->usCapacity)
+    {
+        pxFilter->usCount++;
+    }
+
+    return prvDivideRounded(pxFilter->lSum, prvSamplesInWindow(pxFilter));
+}
+
+int32_t lMovingAverageGetFixed(const MovingAverage_t *pxFilter)
+{
+    uint16_t usInWindow = prvSamplesInWindow(pxFilter);
+    int32_t lQuotient, lRemainder;
+
+    if (usInWindow == 0)
+    {
+        return 0;
+    }
+
+    // Split the division so that the shift cannot overflow the 32-bit sum
+    lQuotient = pxFilter->lSum / usInWindow;
+    lRemainder = pxFilter->lSum % usInWindow;
+
+    return (lQuotient * (1L << movavgFRACTION_BITS)) + ((lRemainder * (1L << movavgFRACTION_BITS)) / usInWindow);
+}
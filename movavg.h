@@ -0,0 +1,97 @@
+/*
+ * movavg.h
+ *
+ * Fixed-point moving-average filter for the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#ifndef MOVAVG_H
+#define MOVAVG_H
+
+#include <stdint.h>
+
+/* Storage type of a single sample in the window, and its range.  Define all
+ * three together to store the samples in another type. */
+#ifndef movavgSAMPLE_TYPE
+    #define movavgSAMPLE_TYPE    int16_t
+    #define movavgSAMPLE_MIN     INT16_MIN
+    #define movavgSAMPLE_MAX     INT16_MAX
+#endif
+
+/* Number of fractional bits returned by lMovingAverageGetFixed(). */
+#ifndef movavgFRACTION_BITS
+    #define movavgFRACTION_BITS  8
+#endif
+
+typedef movavgSAMPLE_TYPE MovAvgSample_t;
+
+/**
+ * @brief State of a moving-average filter.
+ *
+ * The samples are kept in a ring buffer supplied by the caller and the sum of
+ * the samples inside the window is updated incrementally, so adding a sample
+ * costs the same regardless of the window length.  The buffer keeps the last
+ * usCapacity samples, which allows the window to grow again after it has been
+ * reduced without losing history.
+ */
+typedef struct {
+    MovAvgSample_t *psBuffer; /**< Ring buffer with the sample history */
+    uint16_t usCapacity;      /**< Number of entries in psBuffer */
+    uint16_t usWindow;        /**< Current window length (N) */
+    uint16_t usHead;          /**< Index where the next sample is written */
+    uint16_t usCount;         /**< Number of valid samples in the history */
+    int32_t lSum;             /**< Sum of the samples inside the window */
+} MovingAverage_t;
+
+/**
+ * @brief Initialises a moving-average filter over a caller supplied buffer.
+ *
+ * @param pxFilter Filter to initialise.
+ * @param psBuffer Storage for the sample history.
+ * @param usCapacity Number of entries in psBuffer, which is also the largest window.
+ * @param usWindow Initial window length, clamped to [1, usCapacity].
+ */
+void vMovingAverageInit(MovingAverage_t *pxFilter, MovAvgSample_t *psBuffer, uint16_t usCapacity, uint16_t usWindow);
+
+/**
+ * @brief Changes the window length while samples are flowing.
+ *
+ * When the window shrinks the oldest samples are removed from the running sum,
+ * when it grows the older samples still held in the history are added back.
+ * The cost is proportional to the size of the change, not to the window.
+ *
+ * @param pxFilter Filter to update.
+ * @param usWindow New window length, clamped to [1, capacity].
+ */
+void vMovingAverageSetWindow(MovingAverage_t *pxFilter, uint16_t usWindow);
+
+/**
+ * @brief Adds a sample and returns the rounded average of the window.
+ *
+ * While fewer than N samples have been received the average is computed with
+ * the samples available.
+ *
+ * @param pxFilter Filter to update.
+ * @param sSample New sample.
+ * @return int32_t Average of the samples inside the window.
+ */
+int32_t lMovingAverageAdd(MovingAverage_t *pxFilter, MovAvgSample_t sSample);
+
+/**
+ * @brief Returns the current average with movavgFRACTION_BITS fractional bits.
+ *
+ * @param pxFilter Filter to read.
+ * @return int32_t Fixed-point average, 0 if no sample has been added.
+ */
+int32_t lMovingAverageGetFixed(const MovingAverage_t *pxFilter);
+
+/**
+ * @brief Discards the sample history, keeping the buffer and the window length.
+ *
+ * @param pxFilter Filter to reset.
+ */
+void vMovingAverageReset(MovingAverage_t *pxFilter);
+
+#endif /* MOVAVG_H */
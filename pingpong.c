@@ -0,0 +1,82 @@
+/*
+ * pingpong.c
+ *
+ * Double buffered block handoff from an interrupt to a task for the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#include "pingpong.h"
+
+/*-----------------------------------------------------------*/
+
+void vPingPongInit(PingPong_t *pxPingPong, TaskHandle_t xConsumer)
+{
+    pxPingPong->pucFull[0] = 0;
+    pxPingPong->pucFull[1] = 0;
+    pxPingPong->ucFilling = 0;
+    pxPingPong->usCount = 0;
+    pxPingPong->ucReading = 0;
+    pxPingPong->xConsumer = xConsumer;
+}
+
+UBaseType_t uxPingPongWriteFromISR(PingPong_t *pxPingPong, const int32_t *plSamples, UBaseType_t uxCount, uint32_t ulStamp,
+                                   BaseType_t *pxHigherPriorityTaskWoken)
+{
+    UBaseType_t x;
+    uint8_t ucBlock = pxPingPong->ucFilling;
+
+    for (x = 0; x < uxCount; x++)
+    {
+        // The task still owns this block
+        if (pxPingPong->pucFull[ucBlock] != 0)
+        {
+            break;
+        }
+
+        if (pxPingPong->usCount == 0)
+        {
+            pxPingPong->pulStamps[ucBlock] = ulStamp;
+        }
+        pxPingPong->plBlocks[ucBlock][pxPingPong->usCount++] = plSamples[x];
+
+        if (pxPingPong->usCount == pingpongBLOCK_SIZE)
+        {
+            // Hand the block over and carry on in the other one
+            pxPingPong->pucFull[ucBlock] = 1;
+            pxPingPong->usCount = 0;
+            ucBlock ^= 1;
+            vTaskNotifyGiveFromISR(pxPingPong->xConsumer, pxHigherPriorityTaskWoken);
+        }
+    }
+
+    pxPingPong->ucFilling = ucBlock;
+
+    return x;
+}
+
+const int32_t *plPingPongTake(PingPong_t *pxPingPong, TickType_t xTicksToWait)
+{
+    // Blocks are handed over in order, so only the next one needs to be checked
+    while (pxPingPong->pucFull[pxPingPong->ucReading] == 0)
+    {
+        if (ulTaskNotifyTake(pdTRUE, xTicksToWait) == 0)
+        {
+            return NULL;
+        }
+    }
+
+    return pxPingPong->plBlocks[pxPingPong->ucReading];
+}
+
+uint32_t ulPingPongStamp(const PingPong_t *pxPingPong)
+{
+    return pxPingPong->pulStamps[pxPingPong->ucReading];
+}
+
+void vPingPongRelease(PingPong_t *pxPingPong)
+{
+    pxPingPong->pucFull[pxPingPong->ucReading] = 0;
+    pxPingPong->ucReading ^= 1;
+}
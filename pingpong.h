@@ -0,0 +1,85 @@
+/*
+ * pingpong.h
+ *
+ * Double buffered block handoff from an interrupt to a task for the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#ifndef PINGPONG_H
+#define PINGPONG_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Configuration of the ping-pong buffer. */
+#define pingpongBLOCK_SIZE 16 // Samples per block, the consumer is woken once per block
+
+/**
+ * @brief Two blocks of samples, one filled by an interrupt while a task reads the other.
+ *
+ * Like a DMA controller, the interrupt writes straight into the block and
+ * hands it over when it is full, so the samples are never copied.  If the
+ * task has not released a block by the time the interrupt needs it again,
+ * the new samples are dropped.
+ */
+typedef struct {
+    int32_t plBlocks[2][pingpongBLOCK_SIZE]; /**< Sample storage */
+    uint32_t pulStamps[2];                   /**< Time stamp given with the first sample of each block */
+    volatile uint8_t pucFull[2];             /**< Set by the interrupt on handover, cleared by the task on release */
+    uint8_t ucFilling;                       /**< Block being written by the interrupt */
+    uint16_t usCount;                        /**< Samples in the block being written */
+    uint8_t ucReading;                       /**< Next block the task will take */
+    TaskHandle_t xConsumer;                  /**< Task notified when a block is full */
+} PingPong_t;
+
+/**
+ * @brief Initialises both blocks as empty.
+ *
+ * @param pxPingPong Buffer to initialise.
+ * @param xConsumer Task notified whenever a block is full.
+ */
+void vPingPongInit(PingPong_t *pxPingPong, TaskHandle_t xConsumer);
+
+/**
+ * @brief Appends samples to the block being filled, from an interrupt.
+ *
+ * @param pxPingPong Buffer to write.
+ * @param plSamples Samples to append.
+ * @param uxCount Number of samples.
+ * @param ulStamp Time the samples were produced, kept when they start a block.
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the consumer was woken.
+ * @return UBaseType_t Number of samples written, the rest were dropped because both blocks were full.
+ */
+UBaseType_t uxPingPongWriteFromISR(PingPong_t *pxPingPong, const int32_t *plSamples, UBaseType_t uxCount, uint32_t ulStamp,
+                                   BaseType_t *pxHigherPriorityTaskWoken);
+
+/**
+ * @brief Waits for the next full block.
+ *
+ * Must be called by the consumer task only, and followed by vPingPongRelease()
+ * once the samples have been used.
+ *
+ * @param pxPingPong Buffer to read.
+ * @param xTicksToWait Maximum time to wait for a block.
+ * @return const int32_t* The pingpongBLOCK_SIZE samples of the block, NULL if none was filled in time.
+ */
+const int32_t *plPingPongTake(PingPong_t *pxPingPong, TickType_t xTicksToWait);
+
+/**
+ * @brief Returns the time stamp of the oldest sample of the block returned by plPingPongTake().
+ *
+ * @param pxPingPong Buffer the block belongs to.
+ * @return uint32_t Stamp given to uxPingPongWriteFromISR() with the first sample of the block.
+ */
+uint32_t ulPingPongStamp(const PingPong_t *pxPingPong);
+
+/**
+ * @brief Gives the block returned by plPingPongTake() back to the interrupt.
+ *
+ * @param pxPingPong Buffer the block belongs to.
+ */
+void vPingPongRelease(PingPong_t *pxPingPong);
+
+#endif /* PINGPONG_H */
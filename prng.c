@@ -0,0 +1,65 @@
+/*
+ * prng.c
+ *
+ * Pseudo-random number generator for the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#include "prng.h"
+
+/* One xorshift32 step, period 2^32 - 1 over the non-zero states. */
+#define prngSTEP( x )         \
+    do {                      \
+        ( x ) ^= ( x ) << 13; \
+        ( x ) ^= ( x ) >> 17; \
+        ( x ) ^= ( x ) << 5;  \
+    } while( 0 )
+
+/* Maps a 32-bit number to [0, ulBound) with a single multiplication. */
+#define prngSCALE( x, ulBound )    ( ( uint32_t ) ( ( ( uint64_t ) ( x ) * ( ulBound ) ) >> 32 ) )
+
+/*-----------------------------------------------------------*/
+
+void vPrngSeed(Prng_t *pxPrng, uint32_t ulSeed)
+{
+    // Final mix of MurmurHash3, every bit of the seed affects every bit of the state
+    ulSeed ^= ulSeed >> 16;
+    ulSeed *= 0x85EBCA6BUL;
+    ulSeed ^= ulSeed >> 13;
+    ulSeed *= 0xC2B2AE35UL;
+    ulSeed ^= ulSeed >> 16;
+
+    // Zero is the only state xorshift never leaves, and only the seed zero maps to it
+    pxPrng->ulState = (ulSeed != 0) ? ulSeed : 0x6D2B79F5UL;
+}
+
+uint32_t ulPrngNext(Prng_t *pxPrng)
+{
+    uint32_t x = pxPrng->ulState;
+
+    prngSTEP(x);
+    pxPrng->ulState = x;
+
+    return x;
+}
+
+uint32_t ulPrngRange(Prng_t *pxPrng, uint32_t ulBound)
+{
+    return prngSCALE(ulPrngNext(pxPrng), ulBound);
+}
+
+void vPrngFillRange(Prng_t *pxPrng, int32_t *plBuffer, size_t xCount, uint32_t ulBound)
+{
+    uint32_t x = pxPrng->ulState;
+    size_t i;
+
+    for (i = 0; i < xCount; i++)
+    {
+        prngSTEP(x);
+        plBuffer[i] = (int32_t)prngSCALE(x, ulBound);
+    }
+
+    pxPrng->ulState = x;
+}
@@ -0,0 +1,69 @@
+/*
+ * prng.h
+ *
+ * Pseudo-random number generator for the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#ifndef PRNG_H
+#define PRNG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief State of a xorshift32 generator.
+ *
+ * Each task keeps its own generator, so drawing numbers needs no kernel call
+ * nor critical section.  The same seed always gives the same sequence.
+ */
+typedef struct {
+    uint32_t ulState; /**< Never zero */
+} Prng_t;
+
+/**
+ * @brief Seeds a generator.
+ *
+ * The seed is scrambled first, so close seeds give unrelated sequences.
+ *
+ * @param pxPrng Generator to seed.
+ * @param ulSeed Any value, including zero.
+ */
+void vPrngSeed(Prng_t *pxPrng, uint32_t ulSeed);
+
+/**
+ * @brief Returns the next 32-bit number of the sequence.
+ *
+ * @param pxPrng Generator to advance.
+ * @return uint32_t Uniformly distributed number.
+ */
+uint32_t ulPrngNext(Prng_t *pxPrng);
+
+/**
+ * @brief Returns a number between 0 and ulBound - 1.
+ *
+ * Scales with a multiplication instead of a modulo, which avoids the slow
+ * division of the Cortex-M3 and uses the better high bits of the generator.
+ *
+ * @param pxPrng Generator to advance.
+ * @param ulBound Number of possible values, greater than zero.
+ * @return uint32_t Number in [0, ulBound).
+ */
+uint32_t ulPrngRange(Prng_t *pxPrng, uint32_t ulBound);
+
+/**
+ * @brief Fills a buffer with numbers between 0 and ulBound - 1.
+ *
+ * Equivalent to xCount calls to ulPrngRange(), with the state kept in a
+ * register for the whole block.
+ *
+ * @param pxPrng Generator to advance.
+ * @param plBuffer Buffer to fill.
+ * @param xCount Number of values to generate.
+ * @param ulBound Number of possible values, greater than zero.
+ */
+void vPrngFillRange(Prng_t *pxPrng, int32_t *plBuffer, size_t xCount, uint32_t ulBound);
+
+#endif /* PRNG_H */
@@ -0,0 +1,97 @@
+/*
+ * recorder.c
+ *
+ * Binary event trace recorder for the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#include "recorder.h"
+#include "timebase.h"
+
+static volatile uint32_t pulRing[recorderRECORDS];
+static uint32_t ulHead = 0;              // Records reserved so far, the slot is this count modulo the ring size
+static uint32_t ulTail = 0;              // Records handed to the reader so far
+static volatile uint32_t ulLastTime = 0; // Time of the last record, only used to decide when a sync is due
+static volatile int xFrozen = 0;
+static uint32_t ulFrozenOut = 0;         // Events dropped while frozen
+static uint32_t ulObjects = 0;           // Last queue or stream buffer number given
+
+/*-----------------------------------------------------------*/
+
+/* A record only keeps 16 bits of the time, so the counter is read as it is instead of through the 64-bit timebase and its critical section. */
+static uint32_t prvNow(void)
+{
+    return ulTimebaseGetLow() >> recorderTIME_SHIFT;
+}
+
+static void prvWrite(uint32_t ulEvent, uint32_t ulObject)
+{
+    uint32_t ulSlot, ulTime;
+
+    if (xFrozen)
+    {
+        __atomic_fetch_add(&ulFrozenOut, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    // The slot is reserved before the time is read, so a record in a later slot has a later time unless an
+    // interrupt lands between the two; its time is then a few units early, which the signed difference of the
+    // reader absorbs
+    ulSlot = __atomic_fetch_add(&ulHead, 1, __ATOMIC_RELAXED);
+    ulTime = prvNow();
+    if (ulEvent == eRecorderSync)
+    {
+        ulObject = ulTime >> 16;
+    }
+    pulRing[ulSlot % recorderRECORDS] = (ulTime & 0xFFFFUL) | ((ulEvent & 0xFFUL) << 16) | ((ulObject & 0xFFUL) << 24);
+    ulLastTime = ulTime;
+}
+
+/*-----------------------------------------------------------*/
+
+void vRecorderEvent(uint32_t ulEvent, uint32_t ulObject)
+{
+    prvWrite(ulEvent, ulObject);
+}
+
+void vRecorderTick(void)
+{
+    if (prvNow() - ulLastTime >= recorderSYNC_UNITS)
+    {
+        prvWrite(eRecorderSync, 0);
+    }
+}
+
+uint32_t ulRecorderNewObject(void)
+{
+    return __atomic_add_fetch(&ulObjects, 1, __ATOMIC_RELAXED);
+}
+
+void vRecorderFreeze(int xFreeze)
+{
+    xFrozen = xFreeze;
+}
+
+size_t xRecorderRead(uint32_t *pulRecords, size_t xMax, uint32_t *pulLost)
+{
+    uint32_t ulHeadNow = __atomic_load_n(&ulHead, __ATOMIC_ACQUIRE);
+    size_t x;
+
+    // Records older than the ring were overwritten
+    *pulLost = __atomic_exchange_n(&ulFrozenOut, 0, __ATOMIC_RELAXED);
+    if (ulHeadNow - ulTail > recorderRECORDS)
+    {
+        *pulLost += ulHeadNow - ulTail - recorderRECORDS;
+        ulTail = ulHeadNow - recorderRECORDS;
+    }
+
+    for (x = 0; x < xMax && ulTail != ulHeadNow; x++)
+    {
+        pulRecords[x] = pulRing[ulTail % recorderRECORDS];
+        ulTail++;
+    }
+
+    return x;
+}
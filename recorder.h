@@ -0,0 +1,101 @@
+/*
+ * recorder.h
+ *
+ * Binary event trace recorder for the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#ifndef RECORDER_H
+#define RECORDER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Fed by the trace macros defined in FreeRTOSConfig.h when TRACE_RECORDER
+ * is 1, which is why this header only depends on the standard types.
+ *
+ * Every event is a single 32-bit record written into a RAM ring:
+ *
+ *   bits 0-15   timestamp, in units of 2^recorderTIME_SHIFT core cycles, wrapping
+ *   bits 16-23  event, see RecorderEvent_t
+ *   bits 24-31  object: task number, queue or stream buffer number
+ *
+ * A writer reserves its slot with an atomic increment and stores the record
+ * with a single word write, so there is no lock and a record is never seen
+ * half written.  When the ring is full the oldest records are overwritten.
+ * The tick adds a recorderSYNC record whenever nothing was recorded for
+ * 2^14 units, so the reader never sees two records further apart than half
+ * the range of the timestamp and can rebuild the full time.
+ */
+#define recorderRECORDS      64 // Records kept in the ring, a power of two
+#define recorderTIME_SHIFT   4  // Timestamp unit, 2^4 cycles or 0.8 us at 20 MHz
+#define recorderSYNC_UNITS   ( 1UL << 14 ) // Longest time without a record before the tick adds one
+
+/**
+ * @brief Events recorded, stored in bits 16-23 of a record.
+ */
+typedef enum {
+    eRecorderSync = 0,             /**< Keeps the timestamps rebuildable, object holds bits 16-23 of the time */
+    eRecorderSwitchedIn,           /**< Task starts running */
+    eRecorderTaskReady,            /**< Task moved to the Ready state */
+    eRecorderDelay,                /**< Running task blocks in vTaskDelay() or vTaskDelayUntil() */
+    eRecorderQueueSend,            /**< Item sent to a queue, or a mutex given */
+    eRecorderQueueSendFromISR,     /**< Item sent to a queue from an interrupt */
+    eRecorderQueueReceive,         /**< Item received from a queue, or a mutex taken */
+    eRecorderQueueReceiveFromISR,  /**< Item received from a queue in an interrupt */
+    eRecorderQueueBlockSend,       /**< Running task blocks on a full queue */
+    eRecorderQueueBlockReceive,    /**< Running task blocks on an empty queue */
+    eRecorderStreamSend,           /**< Bytes sent to a stream buffer */
+    eRecorderStreamSendFromISR,    /**< Bytes sent to a stream buffer from an interrupt */
+    eRecorderStreamReceive,        /**< Bytes received from a stream buffer */
+    eRecorderStreamReceiveFromISR, /**< Bytes received from a stream buffer in an interrupt */
+    eRecorderStreamBlockSend,      /**< Running task blocks on a full stream buffer */
+    eRecorderStreamBlockReceive,   /**< Running task blocks on an empty stream buffer */
+    eRecorderNotifyTakeBlock,      /**< Running task blocks in ulTaskNotifyTake() */
+    eRecorderNotifyGiveFromISR,    /**< Task notified from an interrupt */
+    eRecorderNotify                /**< Task notified from a task */
+} RecorderEvent_t;
+
+/**
+ * @brief Records an event, from a task or an interrupt, without blocking.
+ *
+ * @param ulEvent Event, see RecorderEvent_t.
+ * @param ulObject Task, queue or stream buffer number, truncated to 8 bits.
+ */
+void vRecorderEvent(uint32_t ulEvent, uint32_t ulObject);
+
+/**
+ * @brief Adds a sync record when nothing was recorded for a while, called from the tick.
+ */
+void vRecorderTick(void);
+
+/**
+ * @brief Returns a new number for a queue or a stream buffer, called when it is created.
+ */
+uint32_t ulRecorderNewObject(void);
+
+/**
+ * @brief Stops or restarts the recording while the ring is read.
+ *
+ * Events that happen while the recorder is frozen are counted as lost.
+ *
+ * @param xFrozen Non-zero to stop, zero to restart.
+ */
+void vRecorderFreeze(int xFrozen);
+
+/**
+ * @brief Takes the records written since the previous call, oldest first.
+ *
+ * The recorder should be frozen while it is read.
+ *
+ * @param pulRecords Receives at most xMax records.
+ * @param xMax Capacity of pulRecords.
+ * @param pulLost Receives the records lost since the previous call, overwritten or frozen out.
+ * @return size_t Number of records copied, 0 once the ring is empty.
+ */
+size_t xRecorderRead(uint32_t *pulRecords, size_t xMax, uint32_t *pulLost);
+
+#endif /* RECORDER_H */
@@ -0,0 +1,206 @@
+/*
+ * serial.c
+ *
+ * Interrupt driven UART transmission and reception for the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#include "DriverLib.h"
+#include "hw_uart.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "serial.h"
+
+#define serialTX_MASK ( serialTX_BUFFER_SIZE - 1 )
+#define serialRX_MASK ( serialRX_BUFFER_SIZE - 1 )
+
+/* Ring of bytes waiting for the transmit FIFO.  The head is only moved by the
+ * writers and the tail only by prvTxFill(), both with the UART interrupt masked. */
+static char pcTxRing[serialTX_BUFFER_SIZE];
+static volatile uint16_t usTxHead = 0;
+static volatile uint16_t usTxTail = 0;
+
+/* Serialises the writers, so only one of them can be waiting for space. */
+static SemaphoreHandle_t xTxMutex = NULL;
+
+/* Given by the ISR when it frees space and the writer is waiting for it. */
+static SemaphoreHandle_t xTxSpace = NULL;
+static volatile BaseType_t xTxWaiting = pdFALSE;
+
+#if configSUPPORT_DYNAMIC_ALLOCATION == 0
+/* Without a heap both semaphores live in the .kernel section with the other kernel objects. */
+static StaticSemaphore_t xTxMutexBuffer __attribute__((section(".kernel")));
+static StaticSemaphore_t xTxSpaceBuffer __attribute__((section(".kernel")));
+#endif
+
+/* Ring of received bytes.  The head is only moved by the ISR and the tail only
+ * by the reading task, so a single reader needs no lock to take bytes. */
+static char pcRxRing[serialRX_BUFFER_SIZE];
+static volatile uint16_t usRxHead = 0;
+static volatile uint16_t usRxTail = 0;
+static volatile uint32_t ulRxDropped = 0;
+
+/* Task waiting in xSerialGetChar(), notified by the ISR when bytes arrive. */
+static TaskHandle_t xRxReader = NULL;
+
+/*-----------------------------------------------------------*/
+
+static uint16_t prvTxUsed(void)
+{
+    return (uint16_t)((usTxHead - usTxTail) & serialTX_MASK);
+}
+
+/* Moves bytes from the ring to the FIFO and leaves the transmit interrupt
+ * enabled only while bytes remain in the ring. */
+static void prvTxFill(void)
+{
+    while ((usTxTail != usTxHead) && UARTSpaceAvail(UART0_BASE))
+    {
+        UARTCharNonBlockingPut(UART0_BASE, pcTxRing[usTxTail]);
+        usTxTail = (usTxTail + 1) & serialTX_MASK;
+    }
+
+    if (usTxTail != usTxHead)
+    {
+        UARTIntEnable(UART0_BASE, UART_INT_TX);
+    }
+    else
+    {
+        UARTIntDisable(UART0_BASE, UART_INT_TX);
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+void vSerialInit(void)
+{
+    #if configSUPPORT_DYNAMIC_ALLOCATION == 0
+    xTxMutex = xSemaphoreCreateMutexStatic(&xTxMutexBuffer);
+    xTxSpace = xSemaphoreCreateBinaryStatic(&xTxSpaceBuffer);
+    #else
+    xTxMutex = xSemaphoreCreateMutex();
+    xTxSpace = xSemaphoreCreateBinary();
+    #endif
+
+    // Interrupt when the transmit FIFO drains to 1/8, leaving time to refill it before it runs dry,
+    // and when the receive FIFO is half full, the receive timeout catches the end of shorter bursts
+    HWREG(UART0_BASE + UART_O_IFLS) = UART_IFLS_TX1_8 | UART_IFLS_RX4_8;
+
+    IntPrioritySet(INT_UART0, configKERNEL_INTERRUPT_PRIORITY);
+}
+
+void vSerialWrite(const char *pcData, size_t xLength)
+{
+    xSemaphoreTake(xTxMutex, portMAX_DELAY);
+
+    while (xLength > 0)
+    {
+        taskENTER_CRITICAL();
+        {
+            // One slot stays empty to tell a full ring from an empty one
+            while ((xLength > 0) && (prvTxUsed() < serialTX_MASK))
+            {
+                pcTxRing[usTxHead] = *pcData++;
+                usTxHead = (usTxHead + 1) & serialTX_MASK;
+                xLength--;
+            }
+            prvTxFill();
+
+            xTxWaiting = (xLength > 0) ? pdTRUE : pdFALSE;
+        }
+        taskEXIT_CRITICAL();
+
+        if (xLength > 0)
+        {
+            // The ISR gives the semaphore once the FIFO has taken bytes from the ring
+            xSemaphoreTake(xTxSpace, portMAX_DELAY);
+        }
+    }
+
+    xSemaphoreGive(xTxMutex);
+}
+
+BaseType_t xSerialPutCharFromISR(char c)
+{
+    UBaseType_t uxSavedInterruptStatus;
+    BaseType_t xReturn = pdFAIL;
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        if (prvTxUsed() < serialTX_MASK)
+        {
+            pcTxRing[usTxHead] = c;
+            usTxHead = (usTxHead + 1) & serialTX_MASK;
+            prvTxFill();
+            xReturn = pdPASS;
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+
+    return xReturn;
+}
+
+void vSerialTxISR(BaseType_t *pxHigherPriorityTaskWoken)
+{
+    prvTxFill();
+
+    if (xTxWaiting != pdFALSE)
+    {
+        xTxWaiting = pdFALSE;
+        xSemaphoreGiveFromISR(xTxSpace, pxHigherPriorityTaskWoken);
+    }
+}
+
+void vSerialRxISR(BaseType_t *pxHigherPriorityTaskWoken)
+{
+    uint16_t usNext;
+    char c;
+
+    while (!(HWREG(UART0_BASE + UART_O_FR) & UART_FR_RXFE))
+    {
+        c = (char)HWREG(UART0_BASE + UART_O_DR);
+        usNext = (usRxHead + 1) & serialRX_MASK;
+
+        if (usNext != usRxTail)
+        {
+            pcRxRing[usRxHead] = c;
+            usRxHead = usNext;
+        }
+        else
+        {
+            ulRxDropped++;
+        }
+    }
+
+    if (xRxReader != NULL)
+    {
+        vTaskNotifyGiveFromISR(xRxReader, pxHigherPriorityTaskWoken);
+    }
+}
+
+BaseType_t xSerialGetChar(char *pc, TickType_t xTicksToWait)
+{
+    xRxReader = xTaskGetCurrentTaskHandle();
+
+    // A byte arriving after the check leaves a notification pending, so the take returns at once
+    while (usRxTail == usRxHead)
+    {
+        if (ulTaskNotifyTake(pdTRUE, xTicksToWait) == 0)
+        {
+            return pdFAIL;
+        }
+    }
+
+    *pc = pcRxRing[usRxTail];
+    usRxTail = (usRxTail + 1) & serialRX_MASK;
+
+    return pdPASS;
+}
+
+uint32_t ulSerialRxDropped(void)
+{
+    return ulRxDropped;
+}
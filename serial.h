@@ -0,0 +1,82 @@
+/*
+ * serial.h
+ *
+ * Interrupt driven UART transmission and reception for the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#ifndef SERIAL_H
+#define SERIAL_H
+
+#include <stddef.h>
+#include "FreeRTOS.h"
+
+/* Configuration of the serial port. */
+#define serialTX_BUFFER_SIZE 128 // Bytes waiting to be transmitted, must be a power of two
+#define serialRX_BUFFER_SIZE 64  // Bytes received and not yet read by a task, must be a power of two
+
+/**
+ * @brief Prepares the rings and the UART0 transmit and receive interrupts.
+ *
+ * Must be called once the UART is configured and before the scheduler starts.
+ * It also gives UART0 the kernel interrupt priority, so its ISR may call the
+ * FromISR API functions.
+ */
+void vSerialInit(void);
+
+/**
+ * @brief Queues bytes for transmission and returns without waiting for the UART.
+ *
+ * The calling task blocks only while the ring is full, until the transmit
+ * interrupt frees some space.  Writes from several tasks are serialised, so
+ * the bytes of one call are never interleaved with those of another task.
+ *
+ * @param pcData Bytes to send.
+ * @param xLength Number of bytes to send.
+ */
+void vSerialWrite(const char *pcData, size_t xLength);
+
+/**
+ * @brief Queues a byte for transmission from an interrupt.
+ *
+ * @param c Byte to send.
+ * @return BaseType_t pdPASS if it was queued, pdFAIL if the ring was full and the byte was dropped.
+ */
+BaseType_t xSerialPutCharFromISR(char c);
+
+/**
+ * @brief Refills the UART transmit FIFO from the ring, called by the UART0 ISR on a transmit interrupt.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a writer waiting for space was woken.
+ */
+void vSerialTxISR(BaseType_t *pxHigherPriorityTaskWoken);
+
+/**
+ * @brief Moves every byte waiting in the UART receive FIFO to the ring, called by the UART0 ISR.
+ *
+ * Only copies bytes, so the time spent in the interrupt does not depend on
+ * what is received.  Bytes that find the ring full are counted and dropped.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the reading task was woken.
+ */
+void vSerialRxISR(BaseType_t *pxHigherPriorityTaskWoken);
+
+/**
+ * @brief Takes the next received byte, waiting for one if the ring is empty.
+ *
+ * Only one task may read from the serial port.
+ *
+ * @param pc Receives the byte.
+ * @param xTicksToWait Maximum time to wait for a byte to arrive.
+ * @return BaseType_t pdPASS if a byte was read, pdFAIL if none arrived in time.
+ */
+BaseType_t xSerialGetChar(char *pc, TickType_t xTicksToWait);
+
+/**
+ * @brief Returns the number of received bytes dropped because the ring was full.
+ */
+uint32_t ulSerialRxDropped(void);
+
+#endif /* SERIAL_H */
@@ -0,0 +1,22 @@
+/*
+ * stack_sizes.h
+ *
+ * Stack depths of the tasks of the cortex_LM3S811 program, in words.
+ *
+ * Replace with the header printed by the Top task when STACK_CALIBRATION
+ * is 1 in header.h.  These values were tuned by hand with WATERMARK_MIN.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#ifndef STACK_SIZES_H
+#define STACK_SIZES_H
+
+#define stackTEMPS_WORDS     52
+#define stackFILTER_WORDS    74
+#define stackGRAPH_WORDS     98
+#define stackTOP_WORDS       146
+#define stackCOMMAND_WORDS   80
+
+#endif /* STACK_SIZES_H */
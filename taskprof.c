@@ -0,0 +1,173 @@
+/*
+ * taskprof.c
+ *
+ * Per-task context switch and blocking profile for the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#include "taskprof.h"
+#include "timebase.h"
+
+#if TASK_PROFILE == 1
+
+/* Profile of a task, one entry of the table. */
+typedef struct {
+    uint64_t ullSwitchedIn;  // Timebase when the task was last switched in
+    uint64_t ullBlockedAt;   // Timebase of the last voluntary switch
+    TaskProfStats_t xStats;
+    uint8_t ucUsed;          // Entry given to a task
+    uint8_t ucBlocked;       // Voluntary switch not followed by the task becoming Ready yet
+} TaskProf_t;
+
+static TaskProf_t xTable[taskprofMAX_TASKS];
+
+/* Task switched out by the last context switch, accounted once the next task is known. */
+static TaskProf_t *pxOutgoing = NULL;
+static int xOutgoingReady = 0;
+
+/*-----------------------------------------------------------*/
+
+static void prvCount(uint16_t *pusHistogram, uint64_t ullCycles)
+{
+    UBaseType_t uxBucket = 0;
+
+    // Width grows by 2^taskprofSHIFT_STEP at every bucket
+    while (uxBucket < taskprofBUCKETS - 1 &&
+           ullCycles >= (1ULL << (taskprofFIRST_SHIFT + uxBucket * taskprofSHIFT_STEP)))
+    {
+        uxBucket++;
+    }
+
+    if (pusHistogram[uxBucket] != 0xFFFF)
+    {
+        pusHistogram[uxBucket]++;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* The hooks below are called by the trace macros, from inside the kernel
+ * with the scheduler or the interrupts already locked. */
+
+void *pvTaskProfAlloc(void)
+{
+    UBaseType_t x;
+
+    for (x = 0; x < taskprofMAX_TASKS; x++)
+    {
+        if (!xTable[x].ucUsed)
+        {
+            xTable[x].ucUsed = 1;
+            xTable[x].ucBlocked = 0;
+            xTable[x].ullSwitchedIn = 0;
+            xTable[x].xStats = (TaskProfStats_t){ 0 };
+            return &xTable[x];
+        }
+    }
+
+    return NULL;
+}
+
+void vTaskProfFree(void *pvProfile)
+{
+    TaskProf_t *pxProf = (TaskProf_t *)pvProfile;
+
+    if (pxProf != NULL)
+    {
+        pxProf->ucUsed = 0;
+    }
+}
+
+void vTaskProfSwitchedOut(void *pvProfile, int xStillReady)
+{
+    // The kernel may pick the same task again, so nothing is accounted yet
+    pxOutgoing = (TaskProf_t *)pvProfile;
+    xOutgoingReady = xStillReady;
+}
+
+void vTaskProfSwitchedIn(void *pvProfile)
+{
+    TaskProf_t *pxIncoming = (TaskProf_t *)pvProfile;
+    uint64_t ullNow;
+
+    if (pxIncoming == pxOutgoing && pxIncoming != NULL)
+    {
+        // Not a switch, the slice of the task goes on
+        return;
+    }
+
+    ullNow = ullTimebaseGet();
+
+    if (pxOutgoing != NULL)
+    {
+        prvCount(pxOutgoing->xStats.pusSlice, ullNow - pxOutgoing->ullSwitchedIn);
+
+        if (xOutgoingReady)
+        {
+            pxOutgoing->xStats.ulInvoluntary++;
+        }
+        else
+        {
+            pxOutgoing->xStats.ulVoluntary++;
+            pxOutgoing->ullBlockedAt = ullNow;
+            pxOutgoing->ucBlocked = 1;
+        }
+    }
+
+    if (pxIncoming != NULL)
+    {
+        pxIncoming->ullSwitchedIn = ullNow;
+    }
+    pxOutgoing = NULL;
+}
+
+void vTaskProfReady(void *pvProfile)
+{
+    TaskProf_t *pxProf = (TaskProf_t *)pvProfile;
+
+    if (pxProf != NULL && pxProf->ucBlocked)
+    {
+        prvCount(pxProf->xStats.pusBlocked, ullTimebaseGet() - pxProf->ullBlockedAt);
+        pxProf->ucBlocked = 0;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskProfGet(TaskHandle_t xTask, TaskProfStats_t *pxStats, BaseType_t xClear)
+{
+    TaskProf_t *pxProf;
+    BaseType_t xFound = pdFALSE;
+
+    taskENTER_CRITICAL();
+    {
+        // Read inside the critical section, a deleted task drops its entry from the trace macro
+        pxProf = (TaskProf_t *)pvTaskGetThreadLocalStoragePointer(xTask, TASK_PROFILE_TLS_INDEX);
+        if (pxProf != NULL)
+        {
+            *pxStats = pxProf->xStats;
+            if (xClear == pdTRUE)
+            {
+                pxProf->xStats = (TaskProfStats_t){ 0 };
+            }
+            xFound = pdTRUE;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xFound;
+}
+
+uint32_t ulTaskProfBucketLimitUs(UBaseType_t uxBucket)
+{
+    if (uxBucket >= taskprofBUCKETS - 1)
+    {
+        return 0;
+    }
+
+    return (uint32_t)((1ULL << (taskprofFIRST_SHIFT + uxBucket * taskprofSHIFT_STEP)) / (configCPU_CLOCK_HZ / 1000000UL));
+}
+
+#endif /* TASK_PROFILE */
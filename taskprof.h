@@ -0,0 +1,66 @@
+/*
+ * taskprof.h
+ *
+ * Per-task context switch and blocking profile for the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#ifndef TASKPROF_H
+#define TASKPROF_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+ * The profile is fed by the trace macros defined in FreeRTOSConfig.h when
+ * TASK_PROFILE is 1.  Every task gets an entry of a fixed table when it is
+ * created, kept in its thread local storage pointer TASK_PROFILE_TLS_INDEX,
+ * so the hooks run in constant time inside the context switch.
+ *
+ * A switch is voluntary when the task leaves the Running state because it
+ * blocked, suspended or deleted itself, and involuntary when it is still
+ * Ready: preempted by a higher priority task, at the end of its time slice or
+ * after taskYIELD().
+ */
+
+/* Configuration of the profile. */
+#define taskprofMAX_TASKS     8  // Tasks profiled at the same time, the rest are not profiled
+#define taskprofBUCKETS       8  // Buckets of each histogram, the last one has no upper limit
+#define taskprofFIRST_SHIFT   10 // Upper limit of the first bucket, 2^10 cycles
+#define taskprofSHIFT_STEP    2  // Each bucket is 2^2 times wider than the previous one
+
+/**
+ * @brief Counters of a task, reset when read with xClear.
+ *
+ * Bucket b of a histogram counts durations below 2^(taskprofFIRST_SHIFT +
+ * b * taskprofSHIFT_STEP) core cycles, the last bucket the rest.  The
+ * counts saturate at 65535.
+ */
+typedef struct {
+    uint32_t ulVoluntary;                   /**< Switches out because the task blocked, suspended or deleted itself */
+    uint32_t ulInvoluntary;                 /**< Switches out while the task was still Ready */
+    uint16_t pusSlice[taskprofBUCKETS];     /**< Histogram of the time the task ran each time it was switched in */
+    uint16_t pusBlocked[taskprofBUCKETS];   /**< Histogram of the time from a voluntary switch to the task being Ready again */
+} TaskProfStats_t;
+
+/**
+ * @brief Reads the profile of a task.
+ *
+ * @param xTask Task to read, NULL for the calling task.
+ * @param pxStats Receives a copy of the counters.
+ * @param xClear pdTRUE to reset the counters, so the next read covers only what happened since.
+ * @return BaseType_t pdFALSE if the task has no profile, because the table was full when it was created.
+ */
+BaseType_t xTaskProfGet(TaskHandle_t xTask, TaskProfStats_t *pxStats, BaseType_t xClear);
+
+/**
+ * @brief Upper limit of a bucket of the histograms.
+ *
+ * @param uxBucket Index of the bucket.
+ * @return uint32_t Limit in microseconds, 0 for the last bucket which has none.
+ */
+uint32_t ulTaskProfBucketLimitUs(UBaseType_t uxBucket);
+
+#endif /* TASKPROF_H */
@@ -0,0 +1,199 @@
+/*
+ * taskstats.c
+ *
+ * Per-task statistics table of the top task for the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#include "taskstats.h"
+
+/*-----------------------------------------------------------*/
+
+static uint32_t prvPermille(uint32_t ulPart, uint32_t ulWhole)
+{
+    if (ulWhole == 0)
+    {
+        return 0;
+    }
+
+    return (uint32_t)(((uint64_t)ulPart * 1000) / ulWhole);
+}
+
+/* Shifts a run time and its window down together until the window fits in 32 bits, the share stays the same. */
+static void prvFit(configRUN_TIME_COUNTER_TYPE ulPart, configRUN_TIME_COUNTER_TYPE ulWhole, uint32_t *pulPart, uint32_t *pulWhole)
+{
+    while (ulWhole > 0xFFFFFFFFUL)
+    {
+        ulPart >>= 1;
+        ulWhole >>= 1;
+    }
+
+    *pulPart = (uint32_t)ulPart;
+    *pulWhole = (uint32_t)ulWhole;
+}
+
+/* Entry holding a task, or the first reusable one on its probe sequence, NULL if neither exists. */
+static TaskStatsEntry_t *prvFind(TaskStats_t *pxStats, UBaseType_t uxNumber)
+{
+    TaskStatsEntry_t *pxEntry, *pxReusable = NULL;
+    UBaseType_t uxSlot = uxNumber % taskstatsMAX_TASKS;
+    UBaseType_t uxProbe;
+
+    for (uxProbe = 0; uxProbe < taskstatsMAX_TASKS; uxProbe++)
+    {
+        pxEntry = &pxStats->xEntries[uxSlot];
+
+        if (pxEntry->ucState == eTaskStatsFree)
+        {
+            // The task is not in the table, a free entry ends the search
+            return (pxReusable != NULL) ? pxReusable : pxEntry;
+        }
+        if (pxEntry->ucState == eTaskStatsUsed && pxEntry->uxNumber == uxNumber)
+        {
+            return pxEntry;
+        }
+        if (pxEntry->ucState == eTaskStatsDeleted && pxReusable == NULL)
+        {
+            pxReusable = pxEntry;
+        }
+
+        uxSlot = (uxSlot + 1) % taskstatsMAX_TASKS;
+    }
+
+    return pxReusable;
+}
+
+/*-----------------------------------------------------------*/
+
+void vTaskStatsInit(TaskStats_t *pxStats)
+{
+    UBaseType_t x;
+
+    for (x = 0; x < taskstatsMAX_TASKS; x++)
+    {
+        pxStats->xEntries[x].ucState = eTaskStatsFree;
+    }
+    pxStats->uxUsed = 0;
+    pxStats->uxUntracked = 0;
+    pxStats->uxUpdated = 0;
+    pxStats->ucRefresh = 0;
+    pxStats->ulTotalRunTime = 0;
+    pxStats->ulWindow = 0;
+    pxStats->ulIdleRunTime = 0;
+    pxStats->ulIdlePermille = 0;
+}
+
+void vTaskStatsBeginRefresh(TaskStats_t *pxStats, configRUN_TIME_COUNTER_TYPE ulTotalRunTime, configRUN_TIME_COUNTER_TYPE ulIdleRunTime)
+{
+    uint32_t ulIdle, ulWindow;
+
+    pxStats->ucRefresh++;
+    pxStats->uxUntracked = 0;
+    pxStats->uxUpdated = 0;
+
+    pxStats->ulWindow = ulTotalRunTime - pxStats->ulTotalRunTime;
+    prvFit(ulIdleRunTime - pxStats->ulIdleRunTime, pxStats->ulWindow, &ulIdle, &ulWindow);
+    pxStats->ulIdlePermille = prvPermille(ulIdle, ulWindow);
+    pxStats->ulTotalRunTime = ulTotalRunTime;
+    pxStats->ulIdleRunTime = ulIdleRunTime;
+}
+
+TaskStatsEntry_t *pxTaskStatsUpdate(TaskStats_t *pxStats, const TaskStatus_t *pxStatus, configRUN_TIME_COUNTER_TYPE ulTotalRunTime)
+{
+    TaskStatsEntry_t *pxEntry = prvFind(pxStats, pxStatus->xTaskNumber);
+
+    if (pxEntry == NULL)
+    {
+        pxStats->uxUntracked++;
+        return NULL;
+    }
+
+    if (pxEntry->ucState != eTaskStatsUsed)
+    {
+        // Created since the previous refresh, everything it ran belongs to this window
+        pxEntry->ucState = eTaskStatsUsed;
+        pxEntry->uxNumber = pxStatus->xTaskNumber;
+        pxEntry->ulRunTime = 0;
+        pxEntry->ulTotalRunTime = pxStats->ulTotalRunTime - pxStats->ulWindow;
+        pxEntry->usMinStack = 0xFFFF;
+        pxStats->uxUsed++;
+    }
+    else if (pxEntry->ucRefresh == pxStats->ucRefresh)
+    {
+        // Returned again by a later page, the first snapshot stands
+        return pxEntry;
+    }
+
+    // The window of each task runs from its own last update, so a refresh it missed is not lost
+    prvFit(pxStatus->ulRunTimeCounter - pxEntry->ulRunTime, ulTotalRunTime - pxEntry->ulTotalRunTime,
+           &pxEntry->ulDelta, &pxEntry->ulWindow);
+    pxEntry->ulRunTime = pxStatus->ulRunTimeCounter;
+    pxEntry->ulTotalRunTime = ulTotalRunTime;
+    if (pxStatus->usStackHighWaterMark < pxEntry->usMinStack)
+    {
+        pxEntry->usMinStack = pxStatus->usStackHighWaterMark;
+    }
+    pxEntry->ucRefresh = pxStats->ucRefresh;
+    pxStats->uxUpdated++;
+
+    return pxEntry;
+}
+
+TaskStatsEntry_t *pxTaskStatsFind(TaskStats_t *pxStats, UBaseType_t uxNumber)
+{
+    TaskStatsEntry_t *pxEntry = prvFind(pxStats, uxNumber);
+
+    if (pxEntry == NULL || pxEntry->ucState != eTaskStatsUsed || pxEntry->uxNumber != uxNumber ||
+        pxEntry->ucRefresh != pxStats->ucRefresh)
+    {
+        return NULL;
+    }
+
+    return pxEntry;
+}
+
+UBaseType_t uxTaskStatsRank(const TaskStats_t *pxStats, const TaskStatsEntry_t *pxEntry)
+{
+    const TaskStatsEntry_t *pxOther;
+    UBaseType_t uxRank = 0;
+    UBaseType_t x;
+
+    for (x = 0; x < taskstatsMAX_TASKS; x++)
+    {
+        pxOther = &pxStats->xEntries[x];
+
+        // Entries left from earlier refreshes belong to tasks not in this table
+        if (pxOther->ucState == eTaskStatsUsed && pxOther->ucRefresh == pxStats->ucRefresh &&
+            (pxOther->ulDelta > pxEntry->ulDelta || (pxOther->ulDelta == pxEntry->ulDelta && pxOther < pxEntry)))
+        {
+            uxRank++;
+        }
+    }
+
+    return uxRank;
+}
+
+void vTaskStatsEndRefresh(TaskStats_t *pxStats)
+{
+    TaskStatsEntry_t *pxEntry;
+    UBaseType_t x;
+
+    for (x = 0; x < taskstatsMAX_TASKS; x++)
+    {
+        pxEntry = &pxStats->xEntries[x];
+
+        if (pxEntry->ucState == eTaskStatsUsed &&
+            (uint8_t)(pxStats->ucRefresh - pxEntry->ucRefresh) >= taskstatsSTALE_REFRESHES)
+        {
+            pxEntry->ucState = eTaskStatsDeleted;
+            pxStats->uxUsed--;
+        }
+    }
+}
+
+uint32_t ulTaskStatsPermille(const TaskStatsEntry_t *pxEntry)
+{
+    return prvPermille(pxEntry->ulDelta, pxEntry->ulWindow);
+}
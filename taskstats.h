@@ -0,0 +1,132 @@
+/*
+ * taskstats.h
+ *
+ * Per-task statistics table of the top task for the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#ifndef TASKSTATS_H
+#define TASKSTATS_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Configuration of the statistics table. */
+#define taskstatsMAX_TASKS       16 // Tasks followed at the same time, the rest are shown without history
+#define taskstatsSTALE_REFRESHES 2  // Refreshes a task may be missing from before its entry is freed
+
+/**
+ * @brief State of an entry of the table.
+ */
+typedef enum {
+    eTaskStatsFree = 0, /**< Never used, ends a search */
+    eTaskStatsUsed,     /**< Holds a task */
+    eTaskStatsDeleted   /**< Held a task that is gone, reusable but does not end a search */
+} TaskStatsState_t;
+
+/**
+ * @brief What is kept about a task from one refresh to the next.
+ */
+typedef struct {
+    UBaseType_t uxNumber;    /**< xTaskNumber of the task */
+    configRUN_TIME_COUNTER_TYPE ulRunTime;      /**< Cumulative run time of the task at its last update */
+    configRUN_TIME_COUNTER_TYPE ulTotalRunTime; /**< Run time counter at its last update */
+    uint32_t ulDelta;        /**< Run time of the task during its last window, scaled down with ulWindow */
+    uint32_t ulWindow;       /**< Run time counter increase during its last window, scaled down to 32 bits */
+    uint16_t usMinStack;     /**< Lowest stack high water mark seen, in words */
+    uint8_t ucState;         /**< TaskStatsState_t of the entry */
+    uint8_t ucRefresh;       /**< Refresh in which the entry was last updated */
+} TaskStatsEntry_t;
+
+/**
+ * @brief Fixed-capacity table of task statistics keyed by xTaskNumber.
+ *
+ * The entry of a task is found by open addressing from xTaskNumber, so every
+ * update costs the same however many tasks there are, and tasks created at
+ * runtime get an entry when they first show up.  Entries of tasks missing
+ * from taskstatsSTALE_REFRESHES refreshes in a row are freed, which covers
+ * deleted tasks and keeps a task returned twice or skipped by a paged
+ * snapshot from losing its history.
+ */
+typedef struct {
+    TaskStatsEntry_t xEntries[taskstatsMAX_TASKS]; /**< Entries, indexed from xTaskNumber */
+    UBaseType_t uxUsed;         /**< Entries holding a task */
+    UBaseType_t uxUntracked;    /**< Tasks of the current refresh that found no entry */
+    UBaseType_t uxUpdated;      /**< Entries updated during the current refresh */
+    uint8_t ucRefresh;          /**< Number of the current refresh */
+    configRUN_TIME_COUNTER_TYPE ulTotalRunTime; /**< Run time counter at the start of the current refresh */
+    configRUN_TIME_COUNTER_TYPE ulWindow;       /**< Run time counter increase since the previous refresh */
+    configRUN_TIME_COUNTER_TYPE ulIdleRunTime;  /**< Run time of the idle task at the start of the current refresh */
+    uint32_t ulIdlePermille;    /**< Share of the window spent in the idle task */
+} TaskStats_t;
+
+/**
+ * @brief Starts with an empty table.
+ *
+ * @param pxStats Table to initialise.
+ */
+void vTaskStatsInit(TaskStats_t *pxStats);
+
+/**
+ * @brief Starts a refresh, before the tasks are passed to pxTaskStatsUpdate().
+ *
+ * @param pxStats Table to refresh.
+ * @param ulTotalRunTime Current run time counter.
+ * @param ulIdleRunTime Current run time of the idle task, from ulTaskGetIdleRunTimeCounter().
+ */
+void vTaskStatsBeginRefresh(TaskStats_t *pxStats, configRUN_TIME_COUNTER_TYPE ulTotalRunTime, configRUN_TIME_COUNTER_TYPE ulIdleRunTime);
+
+/**
+ * @brief Updates the entry of a task with a new snapshot of it.
+ *
+ * A task seen for the first time was created during the window, so all of
+ * its run time counts.  A task already updated during this refresh is left
+ * as it is.
+ *
+ * @param pxStats Table being refreshed.
+ * @param pxStatus Snapshot of the task.
+ * @param ulTotalRunTime Run time counter returned along with the snapshot.
+ * @return TaskStatsEntry_t* Entry of the task, NULL if the table is full.
+ */
+TaskStatsEntry_t *pxTaskStatsUpdate(TaskStats_t *pxStats, const TaskStatus_t *pxStatus, configRUN_TIME_COUNTER_TYPE ulTotalRunTime);
+
+/**
+ * @brief Entry of a task updated during the current refresh.
+ *
+ * @param pxStats Table being refreshed.
+ * @param uxNumber xTaskNumber of the task.
+ * @return TaskStatsEntry_t* Entry of the task, NULL if it has none or it was not updated yet.
+ */
+TaskStatsEntry_t *pxTaskStatsFind(TaskStats_t *pxStats, UBaseType_t uxNumber);
+
+/**
+ * @brief Position of a task from the busiest to the idlest of the current refresh.
+ *
+ * Only the entries updated during the refresh are ranked, so the ranks go
+ * from 0 to uxUpdated - 1 whatever page each task came in.  Tasks with the
+ * same run time are ranked by the position of their entry.
+ *
+ * @param pxStats Table being refreshed.
+ * @param pxEntry Entry of the task, updated during the refresh.
+ * @return UBaseType_t Number of tasks that ran longer during their last window.
+ */
+UBaseType_t uxTaskStatsRank(const TaskStats_t *pxStats, const TaskStatsEntry_t *pxEntry);
+
+/**
+ * @brief Ends a refresh, freeing the entries of the tasks that are gone.
+ *
+ * @param pxStats Table being refreshed.
+ */
+void vTaskStatsEndRefresh(TaskStats_t *pxStats);
+
+/**
+ * @brief Share of its last window used by a task.
+ *
+ * @param pxEntry Entry of the task.
+ * @return uint32_t Tenths of a percent, 1000 is the whole window.
+ */
+uint32_t ulTaskStatsPermille(const TaskStatsEntry_t *pxEntry);
+
+#endif /* TASKSTATS_H */
@@ -0,0 +1,84 @@
+/*
+ * telemetry.c
+ *
+ * Binary telemetry frames for the statistics of the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#include "telemetry.h"
+
+/* Offsets of the fields before the payload. */
+#define telemetryOFFSET_LENGTH  1
+#define telemetryOFFSET_TYPE    2
+#define telemetryOFFSET_PAYLOAD 3
+
+/*-----------------------------------------------------------*/
+
+void vTelemetryBegin(TelemetryFrame_t *pxFrame, uint8_t ucType)
+{
+    pxFrame->pucData[0] = telemetrySYNC;
+    pxFrame->pucData[telemetryOFFSET_TYPE] = ucType;
+    pxFrame->usLength = telemetryOFFSET_PAYLOAD;
+}
+
+void vTelemetryPut8(TelemetryFrame_t *pxFrame, uint8_t ucValue)
+{
+    if (pxFrame->usLength < telemetryOFFSET_PAYLOAD + telemetryMAX_PAYLOAD)
+    {
+        pxFrame->pucData[pxFrame->usLength++] = ucValue;
+    }
+}
+
+void vTelemetryPut16(TelemetryFrame_t *pxFrame, uint16_t usValue)
+{
+    vTelemetryPut8(pxFrame, (uint8_t)usValue);
+    vTelemetryPut8(pxFrame, (uint8_t)(usValue >> 8));
+}
+
+void vTelemetryPut32(TelemetryFrame_t *pxFrame, uint32_t ulValue)
+{
+    vTelemetryPut16(pxFrame, (uint16_t)ulValue);
+    vTelemetryPut16(pxFrame, (uint16_t)(ulValue >> 16));
+}
+
+void vTelemetryPutString(TelemetryFrame_t *pxFrame, const char *pcValue)
+{
+    while (*pcValue != '\0')
+    {
+        vTelemetryPut8(pxFrame, (uint8_t)*pcValue++);
+    }
+}
+
+uint16_t usTelemetryEnd(TelemetryFrame_t *pxFrame)
+{
+    uint16_t usCrc;
+
+    pxFrame->pucData[telemetryOFFSET_LENGTH] = (uint8_t)(pxFrame->usLength - telemetryOFFSET_PAYLOAD);
+
+    // The CRC covers everything but the sync byte
+    usCrc = usTelemetryCrc16(&pxFrame->pucData[telemetryOFFSET_LENGTH], pxFrame->usLength - telemetryOFFSET_LENGTH, 0xFFFF);
+    pxFrame->pucData[pxFrame->usLength++] = (uint8_t)usCrc;
+    pxFrame->pucData[pxFrame->usLength++] = (uint8_t)(usCrc >> 8);
+
+    return pxFrame->usLength;
+}
+
+uint16_t usTelemetryCrc16(const uint8_t *pucData, size_t xLength, uint16_t usCrc)
+{
+    size_t i;
+    int iBit;
+
+    // Bitwise, the frames are short enough not to need a 512-byte table
+    for (i = 0; i < xLength; i++)
+    {
+        usCrc ^= (uint16_t)(pucData[i] << 8);
+        for (iBit = 0; iBit < 8; iBit++)
+        {
+            usCrc = (usCrc & 0x8000) ? (uint16_t)((usCrc << 1) ^ 0x1021) : (uint16_t)(usCrc << 1);
+        }
+    }
+
+    return usCrc;
+}
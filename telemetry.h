@@ -0,0 +1,102 @@
+/*
+ * telemetry.h
+ *
+ * Binary telemetry frames for the statistics of the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Every frame is laid out as
+ *
+ *   SYNC  LEN  TYPE  PAYLOAD (LEN bytes)  CRC (2 bytes)
+ *
+ * with the CRC-16/CCITT of LEN, TYPE and the payload.  Multi-byte fields are
+ * little endian.  A receiver that loses track looks for the next SYNC byte
+ * and drops any frame whose CRC does not match, so text sent on the same UART
+ * is skipped.
+ *
+ * Statistics frame, telemetryTYPE_STATS:
+ *   u32 total run time (ms), u32 window run time (us), u32 free heap, u16 idle permille,
+ *   u8 number of tasks, u8 index of the first record in this frame,
+ *   where the number of tasks is one past the last record of the frame
+ *   until the last frame of the set, since a paged sender learns it last,
+ *   then one record per task: u8 task number, u8 state, u8 priority,
+ *   u16 stack high water mark (words), u32 run time during the window (us).
+ *
+ * Name frame, telemetryTYPE_NAME:
+ *   u8 task number, then the characters of the name without a terminator.
+ *
+ * Trace information frame, telemetryTYPE_TRACE_INFO:
+ *   u32 core clock (Hz), u8 shift of the timestamp unit in core cycles.
+ *
+ * Trace frame, telemetryTYPE_TRACE:
+ *   u32 records lost since the previous trace frame, then the records of
+ *   the recorder (see recorder.h) as u32, oldest first.  A trace frame
+ *   without records ends the dump.
+ */
+#define telemetrySYNC           0xA5
+#define telemetryTYPE_STATS     'S'
+#define telemetryTYPE_NAME      'N'
+#define telemetryTYPE_TRACE_INFO 'I'
+#define telemetryTYPE_TRACE     'T'
+#define telemetryMAX_PAYLOAD    96 // Max payload of a frame, bounds the buffer of the sender
+#define telemetryOVERHEAD       5  // Sync, length, type and CRC bytes
+#define telemetrySTATS_HEADER   16 // Payload bytes of a statistics frame before the records
+#define telemetrySTATS_RECORD   9  // Payload bytes of each task record
+#define telemetryTRACE_HEADER   4  // Payload bytes of a trace frame before the records
+
+/**
+ * @brief A frame being built, ready to be sent once finished.
+ */
+typedef struct {
+    uint8_t pucData[telemetryMAX_PAYLOAD + telemetryOVERHEAD]; /**< Whole frame */
+    uint16_t usLength;                                         /**< Bytes written so far */
+} TelemetryFrame_t;
+
+/**
+ * @brief Starts a frame, dropping anything written before.
+ *
+ * @param pxFrame Frame to build.
+ * @param ucType Kind of frame.
+ */
+void vTelemetryBegin(TelemetryFrame_t *pxFrame, uint8_t ucType);
+
+/**
+ * @brief Appends little-endian fields to the payload, ignored once the payload is full.
+ */
+void vTelemetryPut8(TelemetryFrame_t *pxFrame, uint8_t ucValue);
+void vTelemetryPut16(TelemetryFrame_t *pxFrame, uint16_t usValue);
+void vTelemetryPut32(TelemetryFrame_t *pxFrame, uint32_t ulValue);
+
+/**
+ * @brief Appends the characters of a string, without its terminator.
+ */
+void vTelemetryPutString(TelemetryFrame_t *pxFrame, const char *pcValue);
+
+/**
+ * @brief Writes the length and the CRC of the frame.
+ *
+ * @param pxFrame Frame to finish.
+ * @return uint16_t Total bytes of the frame, to be sent from pxFrame->pucData.
+ */
+uint16_t usTelemetryEnd(TelemetryFrame_t *pxFrame);
+
+/**
+ * @brief CRC-16/CCITT (polynomial 0x1021, initial value 0xFFFF) of a buffer.
+ *
+ * @param pucData Bytes to check.
+ * @param xLength Number of bytes.
+ * @param usCrc Initial value, 0xFFFF or the CRC of the previous bytes.
+ * @return uint16_t CRC of the bytes.
+ */
+uint16_t usTelemetryCrc16(const uint8_t *pucData, size_t xLength, uint16_t usCrc);
+
+#endif /* TELEMETRY_H */
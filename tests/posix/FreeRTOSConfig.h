@@ -0,0 +1,63 @@
+/*
+ * FreeRTOSConfig.h of the POSIX simulations of tests/posix.
+ *
+ * The kernel options under test are set from the command line, see Makefile:
+ * WHEEL for configUSE_TIMING_WHEEL, LIMIT for configTICK_UNBLOCK_LIMIT,
+ * BITMAP for configUSE_BITMAP_TASK_SELECTION with 1024 priorities and CLZ for
+ * configUSE_BITMAP_BUILTIN_CLZ.
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#define configUSE_PREEMPTION			1
+#define configUSE_IDLE_HOOK				0
+#define configUSE_TICK_HOOK				0
+#define configTICK_RATE_HZ				1000
+#define configMINIMAL_STACK_SIZE		4096
+#define configTOTAL_HEAP_SIZE			( 64 * 1024 * 1024 )
+#define configMAX_TASK_NAME_LEN			16
+#define configUSE_TRACE_FACILITY		1
+#define configUSE_16_BIT_TICKS			0
+#define configIDLE_SHOULD_YIELD			1
+#define configUSE_MUTEXES				1
+#define configUSE_TIME_SLICING			1
+#define configSUPPORT_DYNAMIC_ALLOCATION	1
+#define configSUPPORT_STATIC_ALLOCATION	0
+#define configCHECK_FOR_STACK_OVERFLOW	0
+#define configUSE_MALLOC_FAILED_HOOK	0
+#define configUSE_TIMERS				0
+#define configUSE_TASK_NOTIFICATIONS	1
+
+/* Start 4096 ticks before the 32-bit tick count overflows, so every run
+crosses it. */
+#define configINITIAL_TICK_COUNT		( ( TickType_t ) 0xFFFFF000UL )
+
+#define configUSE_TIMING_WHEEL			WHEEL
+#define configTIMING_WHEEL_SIZE			32
+#define configTICK_UNBLOCK_LIMIT		LIMIT
+
+#if ( BITMAP == 1 )
+	#define configUSE_BITMAP_TASK_SELECTION	1
+	#define configMAX_PRIORITIES			1024
+	#define configUSE_BITMAP_BUILTIN_CLZ	CLZ
+#else
+	#define configMAX_PRIORITIES			8
+#endif
+
+/* Lets the tests reach the static functions of tasks.c, see
+freertos_tasks_c_additions.h. */
+#define configINCLUDE_FREERTOS_TASK_C_ADDITIONS_H	1
+
+#define INCLUDE_vTaskDelay				1
+#define INCLUDE_xTaskDelayUntil			1
+#define INCLUDE_vTaskDelete				1
+#define INCLUDE_vTaskSuspend			1
+#define INCLUDE_uxTaskPriorityGet		1
+#define INCLUDE_eTaskGetState			1
+#define INCLUDE_xTaskGetHandle			1
+
+extern void vAssertCalled( const char * pcFile, unsigned long ulLine );
+#define configASSERT( x )	if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ )
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,217 @@
+/*
+ * bitmap.c
+ *
+ * Runs on the POSIX port of Source with configUSE_BITMAP_TASK_SELECTION and
+ * 1024 priorities, built with CLZ=1 for __builtin_clz() and CLZ=0 for the
+ * de Bruijn sequence of other compilers:
+ *
+ *  - The bit scan of the selection gives the same result as a plain loop for
+ *    every single bit and for BIT_SCAN_WORDS pseudo-random words.
+ *  - ORDER_TASKS tasks created at distinct priorities spread over every group
+ *    of 32 run from the highest priority down.
+ *  - A task at priority 40 holding a mutex inherits priority 1000 from the
+ *    task that waits for it, runs ahead of a busy task at priority 500, and
+ *    goes back to 40 when it gives the mutex.
+ *
+ * The run fails on the first assert or with a non-zero exit status.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#define BIT_SCAN_WORDS		20000000UL
+#define ORDER_TASKS			200
+#define LOW_PRIORITY		40
+#define BUSY_PRIORITY		500
+#define HIGH_PRIORITY		1000
+#define CHECK_PRIORITY		( configMAX_PRIORITIES - 1 )
+
+/* Defined in freertos_tasks_c_additions.h, inside tasks.c. */
+extern UBaseType_t uxTestBitmapHighestBit( uint32_t ulBits );
+
+static volatile UBaseType_t uxOrder[ ORDER_TASKS ];
+static volatile int iRan;
+static SemaphoreHandle_t xMutex;
+static volatile int iRelease;
+static volatile int iHighTookMutex;
+static int iFailures;
+
+static void prvCheck( int iCondition, const char *pcWhat )
+{
+	if( !iCondition )
+	{
+		printf( "  failed: %s\n", pcWhat );
+		iFailures++;
+	}
+}
+
+static UBaseType_t prvHighestBitLoop( uint32_t ulBits )
+{
+	UBaseType_t uxBit = 31;
+
+	while( ( ulBits & ( 1UL << uxBit ) ) == 0 )
+	{
+		uxBit--;
+	}
+
+	return uxBit;
+}
+
+static void prvCheckBitScan( void )
+{
+	uint32_t ulWord = 0x12345678UL;
+	unsigned long ulWrong = 0;
+	unsigned long i;
+
+	for( i = 0; i < 32; i++ )
+	{
+		if( uxTestBitmapHighestBit( 1UL << i ) != i )
+		{
+			ulWrong++;
+		}
+	}
+
+	for( i = 0; i < BIT_SCAN_WORDS; i++ )
+	{
+		/* xorshift32, never zero. */
+		ulWord ^= ulWord << 13;
+		ulWord ^= ulWord >> 17;
+		ulWord ^= ulWord << 5;
+
+		/* Also shift the words right, so the high bits are not all set. */
+		if( uxTestBitmapHighestBit( ulWord >> ( i % 32 ) | 1UL ) != prvHighestBitLoop( ulWord >> ( i % 32 ) | 1UL ) )
+		{
+			ulWrong++;
+		}
+	}
+
+	printf( "  bit scan: %lu wrong of %lu words\n", ulWrong, BIT_SCAN_WORDS + 32 );
+	prvCheck( ulWrong == 0, "bit scan" );
+}
+
+static void vOnceTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	uxOrder[ iRan++ ] = uxTaskPriorityGet( NULL );
+	vTaskDelete( NULL );
+}
+
+static void vLowTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	xSemaphoreTake( xMutex, portMAX_DELAY );
+
+	/* Only runs on while the busy task leaves it the processor. */
+	while( iRelease == 0 )
+	{
+	}
+
+	xSemaphoreGive( xMutex );
+
+	for( ;; )
+	{
+		vTaskDelay( portMAX_DELAY );
+	}
+}
+
+static void vHighTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	xSemaphoreTake( xMutex, portMAX_DELAY );
+	iHighTookMutex = 1;
+	xSemaphoreGive( xMutex );
+	vTaskDelete( NULL );
+}
+
+static void vBusyTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+	}
+}
+
+static void vCheckTask( void *pvParameters )
+{
+	TaskHandle_t xLow;
+	UBaseType_t uxPriority;
+	int i;
+
+	( void ) pvParameters;
+
+	prvCheckBitScan();
+
+	/* 389 and 1021 are coprime, so the priorities are distinct and cover
+	 * 1 to 1021.  None runs before this task blocks. */
+	for( i = 0; i < ORDER_TASKS; i++ )
+	{
+		uxPriority = 1 + ( ( UBaseType_t ) i * 389U ) % 1021U;
+		xTaskCreate( vOnceTask, "Once", configMINIMAL_STACK_SIZE, NULL, uxPriority, NULL );
+	}
+
+	vTaskDelay( 10 );
+
+	prvCheck( iRan == ORDER_TASKS, "every task ran" );
+	for( i = 1; i < iRan; i++ )
+	{
+		if( uxOrder[ i ] >= uxOrder[ i - 1 ] )
+		{
+			prvCheck( 0, "priority order" );
+			break;
+		}
+	}
+	printf( "  order: %d tasks, first priority %lu, last %lu\n", iRan,
+			( unsigned long ) uxOrder[ 0 ], ( unsigned long ) uxOrder[ iRan - 1 ] );
+
+	/* The low task takes the mutex, then the busy task would starve it. */
+	xMutex = xSemaphoreCreateMutex();
+	xTaskCreate( vLowTask, "Low", configMINIMAL_STACK_SIZE, NULL, LOW_PRIORITY, &xLow );
+	vTaskDelay( 2 );
+	xTaskCreate( vBusyTask, "Busy", configMINIMAL_STACK_SIZE, NULL, BUSY_PRIORITY, NULL );
+	xTaskCreate( vHighTask, "High", configMINIMAL_STACK_SIZE, NULL, HIGH_PRIORITY, NULL );
+	vTaskDelay( 2 );
+
+	uxPriority = uxTaskPriorityGet( xLow );
+	prvCheck( uxPriority == HIGH_PRIORITY, "inherited priority" );
+
+	iRelease = 1;
+	vTaskDelay( 2 );
+
+	prvCheck( iHighTookMutex == 1, "high task took the mutex" );
+	prvCheck( uxTaskPriorityGet( xLow ) == LOW_PRIORITY, "priority restored" );
+	printf( "  mutex: low task at %lu while held, %lu after, high task %s the mutex\n",
+			( unsigned long ) uxPriority, ( unsigned long ) uxTaskPriorityGet( xLow ),
+			iHighTookMutex ? "took" : "did not take" );
+
+	printf( "BITMAP CLZ=%d: %s\n", CLZ, ( iFailures == 0 ) ? "passed" : "FAILED" );
+	exit( ( iFailures == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE );
+}
+
+int main( void )
+{
+	/* Unbuffered, so the output before an assert is not lost. */
+	setvbuf( stdout, NULL, _IONBF, 0 );
+
+	xTaskCreate( vCheckTask, "Check", configMINIMAL_STACK_SIZE, NULL, CHECK_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	return EXIT_FAILURE;
+}
+
+void vAssertCalled( const char *pcFile, unsigned long ulLine )
+{
+	printf( "assert failed: %s:%lu\n", pcFile, ulLine );
+	abort();
+}
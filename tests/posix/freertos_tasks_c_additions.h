@@ -0,0 +1,22 @@
+/*
+ * freertos_tasks_c_additions.h
+ *
+ * Included at the end of Source/tasks.c by the POSIX simulations, so they can
+ * check its static functions directly.
+ */
+
+#ifndef FREERTOS_TASKS_C_ADDITIONS_H
+#define FREERTOS_TASKS_C_ADDITIONS_H
+
+#if ( configUSE_BITMAP_TASK_SELECTION == 1 )
+
+/* The bit scan the bitmap task selection uses, __builtin_clz() or the de
+ * Bruijn sequence depending on configUSE_BITMAP_BUILTIN_CLZ. */
+UBaseType_t uxTestBitmapHighestBit( uint32_t ulBits )
+{
+	return taskBITMAP_HIGHEST_BIT( ulBits );
+}
+
+#endif
+
+#endif /* FREERTOS_TASKS_C_ADDITIONS_H */
@@ -0,0 +1,148 @@
+/*
+ * wakeup.c
+ *
+ * Runs on the POSIX port of Source and checks the wake times of periodic
+ * tasks across the overflow of the tick count:
+ *
+ *  - WORKERS tasks wake together every PERIOD ticks with vTaskDelayUntil().
+ *  - SLEEPERS tasks wake every SLEEPER_PERIOD ticks, a multiple of the wheel
+ *    size, so with configUSE_TIMING_WHEEL they sit in the slots of the
+ *    workers on later turns of the wheel.
+ *  - With HOG defined a busy task at priority 1 keeps the idle task from
+ *    draining the backlog, so only the ticks unblock tasks.
+ *
+ * No task may wake before its time and every task must keep running.  The
+ * run fails on the first assert or with a non-zero exit status.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define WORKERS			60
+#define PERIOD			10
+#define SLEEPERS		40
+#define SLEEPER_PERIOD	( 10 * configTIMING_WHEEL_SIZE )
+#define RUN_TICKS		5000
+
+static volatile unsigned long ulRuns[ WORKERS + SLEEPERS ];
+static volatile TickType_t xMaxLate[ WORKERS + SLEEPERS ];
+static volatile unsigned long ulEarly;
+
+static void vPeriodicTask( void *pvParameters )
+{
+	const int iTask = ( int ) ( long ) pvParameters;
+	const TickType_t xPeriod = ( iTask < WORKERS ) ? PERIOD : SLEEPER_PERIOD;
+	TickType_t xLastWake = xTaskGetTickCount();
+	TickType_t xLate;
+
+	for( ;; )
+	{
+		vTaskDelayUntil( &xLastWake, xPeriod );
+
+		/* Wrapping subtraction, a task woken early gives a huge lateness. */
+		xLate = xTaskGetTickCount() - xLastWake;
+
+		if( xLate > ( TickType_t ) 0x80000000UL )
+		{
+			ulEarly++;
+		}
+		else if( xLate > xMaxLate[ iTask ] )
+		{
+			xMaxLate[ iTask ] = xLate;
+		}
+
+		ulRuns[ iTask ]++;
+	}
+}
+
+#ifdef HOG
+static void vHogTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+	}
+}
+#endif
+
+static void vCheckTask( void *pvParameters )
+{
+	unsigned long ulFewest = ~0UL;
+	TickType_t xLatest = 0;
+	int i;
+
+	( void ) pvParameters;
+
+	vTaskDelay( RUN_TICKS );
+
+	for( i = 0; i < WORKERS + SLEEPERS; i++ )
+	{
+		if( ulRuns[ i ] < ulFewest )
+		{
+			ulFewest = ulRuns[ i ];
+		}
+
+		if( xMaxLate[ i ] > xLatest )
+		{
+			xLatest = xMaxLate[ i ];
+		}
+	}
+
+	printf( "WHEEL=%d LIMIT=%d%s: fewest runs %lu, latest wake %lu ticks, early wakes %lu\n",
+			WHEEL, LIMIT,
+#ifdef HOG
+			" HOG",
+#else
+			"",
+#endif
+			ulFewest, ( unsigned long ) xLatest, ulEarly );
+
+#if ( LIMIT > 0 )
+	{
+		TickUnblockStats_t xStats;
+
+		vTaskGetTickUnblockStats( &xStats );
+		printf( "  backlogs %lu, deferred ticks %lu, longest backlog %lu ticks\n",
+				( unsigned long ) xStats.ulBacklogs, ( unsigned long ) xStats.ulDeferredTicks,
+				( unsigned long ) xStats.xLongestBacklog );
+	}
+#endif
+
+	/* Every sleeper wakes at least RUN_TICKS / SLEEPER_PERIOD - 1 times. */
+	exit( ( ulEarly == 0 ) && ( ulFewest >= ( RUN_TICKS / SLEEPER_PERIOD ) - 1 ) ? EXIT_SUCCESS : EXIT_FAILURE );
+}
+
+int main( void )
+{
+	int i;
+
+	setvbuf( stdout, NULL, _IONBF, 0 );
+
+	for( i = 0; i < WORKERS + SLEEPERS; i++ )
+	{
+		xTaskCreate( vPeriodicTask, "Periodic", configMINIMAL_STACK_SIZE, ( void * ) ( long ) i, 1 + ( i % 3 ), NULL );
+	}
+
+#ifdef HOG
+	xTaskCreate( vHogTask, "Hog", configMINIMAL_STACK_SIZE, NULL, 1, NULL );
+#endif
+
+	xTaskCreate( vCheckTask, "Check", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+
+	vTaskStartScheduler();
+
+	return EXIT_FAILURE;
+}
+
+void vAssertCalled( const char *pcFile, unsigned long ulLine )
+{
+	printf( "assert failed: %s:%lu\n", pcFile, ulLine );
+	abort();
+}
@@ -0,0 +1,101 @@
+/*
+ * timebase.c
+ *
+ * Free-running 64-bit timebase of the run time statistics for the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#include "FreeRTOS.h"
+#include "hw_ints.h"
+#include "hw_memmap.h"
+#include "hw_timer.h"
+#include "hw_types.h"
+#include "sysctl.h"
+#include "timer.h"
+#include "timebase.h"
+
+static int xUseDwt = 0;
+static uint32_t ulLastLow = 0;  // Last 32-bit reading, to detect the wraps
+static uint32_t ulHigh = 0;     // Wraps seen so far, upper half of the timebase
+
+/*-----------------------------------------------------------*/
+
+/* Current 32-bit count, going up at the core clock. */
+static uint32_t prvReadLow(void)
+{
+    if (xUseDwt)
+    {
+        return timebaseDWT_CYCCNT_REG;
+    }
+
+    // Timer0 counts down from all ones
+    return ~HWREG(TIMER0_BASE + TIMER_O_TAR);
+}
+
+/*-----------------------------------------------------------*/
+
+void vTimebaseInit(void)
+{
+    volatile uint32_t ulSpin;
+    uint32_t ulStart;
+
+    // Try the cycle counter first, some Cortex-M3 parts and emulators leave it out
+    if ((timebaseDWT_CTRL_REG & timebaseDWT_CTRL_NOCYCCNT) == 0)
+    {
+        timebaseDEMCR_REG |= timebaseDEMCR_TRCENA;
+        timebaseDWT_CYCCNT_REG = 0;
+        timebaseDWT_CTRL_REG |= timebaseDWT_CTRL_CYCCNTENA;
+
+        ulStart = timebaseDWT_CYCCNT_REG;
+        for (ulSpin = 0; ulSpin < 4; ulSpin++)
+        {
+        }
+        xUseDwt = (timebaseDWT_CYCCNT_REG != ulStart);
+    }
+
+    if (!xUseDwt)
+    {
+        // A periodic timer reloads at zero by itself, no interrupt is enabled
+        SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER0);
+        TimerConfigure(TIMER0_BASE, TIMER_CFG_32_BIT_PER);
+        TimerLoadSet(TIMER0_BASE, TIMER_A, 0xFFFFFFFFUL);
+        TimerEnable(TIMER0_BASE, TIMER_A);
+    }
+
+    ulLastLow = prvReadLow();
+    ulHigh = 0;
+}
+
+uint64_t ullTimebaseGet(void)
+{
+    UBaseType_t uxSavedInterruptStatus;
+    uint32_t ulLow;
+    uint64_t ullNow;
+
+    // Called from the context switch with the interrupts already masked, so the mask is saved and restored
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        ulLow = prvReadLow();
+        if (ulLow < ulLastLow)
+        {
+            ulHigh++;
+        }
+        ulLastLow = ulLow;
+        ullNow = ((uint64_t)ulHigh << 32) | ulLow;
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+
+    return ullNow;
+}
+
+uint32_t ulTimebaseGetLow(void)
+{
+    return prvReadLow();
+}
+
+int xTimebaseUsesDwt(void)
+{
+    return xUseDwt;
+}
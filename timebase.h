@@ -0,0 +1,63 @@
+/*
+ * timebase.h
+ *
+ * Free-running 64-bit timebase of the run time statistics for the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include <stdint.h>
+
+/*
+ * Cycle counter of the DWT, used when the core implements it.  Otherwise
+ * Timer0 runs as a free 32-bit down-counter at the core clock.  Neither
+ * raises interrupts: the 32-bit reading is extended to 64 bits in software,
+ * which only needs a reading at least once per wrap, 214 s at 20 MHz, and
+ * the scheduler reads it at every context switch.
+ */
+#define timebaseDWT_CTRL_REG     ( *( ( volatile uint32_t * ) 0xE0001000 ) )
+#define timebaseDWT_CYCCNT_REG   ( *( ( volatile uint32_t * ) 0xE0001004 ) )
+#define timebaseDEMCR_REG        ( *( ( volatile uint32_t * ) 0xE000EDFC ) )
+#define timebaseDWT_CTRL_CYCCNTENA   ( 1UL << 0 )
+#define timebaseDWT_CTRL_NOCYCCNT    ( 1UL << 25 )
+#define timebaseDEMCR_TRCENA         ( 1UL << 24 )
+
+/**
+ * @brief Starts the timebase, from the DWT cycle counter if there is one or from Timer0.
+ *
+ * Called by the kernel through portCONFIGURE_TIMER_FOR_RUN_TIME_STATS(),
+ * after the system clock is set.
+ */
+void vTimebaseInit(void);
+
+/**
+ * @brief Reads the timebase, in core clock cycles since vTimebaseInit().
+ *
+ * Safe from tasks and from interrupts up to configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ *
+ * @return uint64_t Cycles elapsed, never wraps in practice.
+ */
+uint64_t ullTimebaseGet(void);
+
+/**
+ * @brief Reads the 32-bit counter under the timebase, without masking the interrupts.
+ *
+ * Wraps every 2^32 cycles and does not count the wraps, for callers that
+ * only need short differences, from any interrupt priority.
+ *
+ * @return uint32_t Low 32 bits of the timebase.
+ */
+uint32_t ulTimebaseGetLow(void);
+
+/**
+ * @brief Tells which counter drives the timebase.
+ *
+ * @return int Non-zero for the DWT cycle counter, zero for Timer0.
+ */
+int xTimebaseUsesDwt(void);
+
+#endif /* TIMEBASE_H */
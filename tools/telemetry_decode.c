@@ -0,0 +1,222 @@
+/*
+ * telemetry_decode.c
+ *
+ * Host decoder of the binary telemetry frames of the cortex_LM3S811 program.
+ * Reads the UART output from a serial device or from standard input and
+ * prints the top table every time a complete set of statistics arrives.
+ *
+ *   make tools/telemetry_decode
+ *   tools/telemetry_decode /dev/ttyUSB0
+ *   qemu-system-arm ... -serial stdio | tools/telemetry_decode
+ *
+ * Text sent on the same UART, like the answers to the commands, is passed
+ * through to standard error.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+
+#include "telemetry.h"
+
+#define MAX_TASKS 256
+
+typedef enum { WAIT_SYNC, WAIT_LENGTH, WAIT_BODY } ParserState;
+
+typedef struct {
+    ParserState state;
+    unsigned char frame[telemetryMAX_PAYLOAD + telemetryOVERHEAD];
+    size_t length; /* bytes of the frame received so far, sync included */
+    size_t expected;
+} Parser;
+
+typedef struct {
+    unsigned number, state, priority, watermark;
+    unsigned long delta;
+} Record;
+
+static char names[MAX_TASKS][32];
+static Record records[MAX_TASKS];
+static unsigned long crc_errors;
+
+static const char *state_name(unsigned state)
+{
+    static const char *const names[] = { "Running", "Ready", "Blocked", "Suspended", "Deleted" };
+    return (state < sizeof(names) / sizeof(names[0])) ? names[state] : "Unknown";
+}
+
+static unsigned long get_le(const unsigned char *p, int bytes)
+{
+    unsigned long value = 0;
+    while (bytes-- > 0) {
+        value = (value << 8) | p[bytes];
+    }
+    return value;
+}
+
+static void print_table(unsigned long total, unsigned long window, unsigned long heap, unsigned idle, unsigned count)
+{
+    unsigned i;
+
+    printf("\nTask Name      State        Priority   Stack(Words)  Task Number  CPU(%%)\n");
+    for (i = 0; i < count; i++) {
+        const Record *r = &records[i];
+        char cpu[24];
+
+        if (r->delta == 0xFFFFFFFFUL || window == 0) {
+            snprintf(cpu, sizeof(cpu), "-");
+        } else {
+            unsigned long permille = (unsigned long)((unsigned long long)r->delta * 1000 / window);
+            snprintf(cpu, sizeof(cpu), "%lu.%lu", permille / 10, permille % 10);
+        }
+        printf("%-15s%-13s%-11u%-14u%-13u%s\n", names[r->number][0] ? names[r->number] : "?",
+               state_name(r->state), r->priority, r->watermark, r->number, cpu);
+    }
+    printf("Total Run Time: %lu ms\nIdle: %u.%u %%\nFree heap: %lu bytes\n", total, idle / 10, idle % 10, heap);
+    if (crc_errors > 0) {
+        printf("Frames dropped: %lu\n", crc_errors);
+    }
+    fflush(stdout);
+}
+
+static void handle_frame(const unsigned char *frame)
+{
+    unsigned length = frame[1];
+    unsigned type = frame[2];
+    const unsigned char *payload = frame + 3;
+
+    if (type == telemetryTYPE_NAME && length >= 1) {
+        size_t name_length = length - 1;
+        if (name_length >= sizeof(names[0])) {
+            name_length = sizeof(names[0]) - 1;
+        }
+        memcpy(names[payload[0]], payload + 1, name_length);
+        names[payload[0]][name_length] = '\0';
+    } else if (type == telemetryTYPE_STATS && length >= telemetrySTATS_HEADER) {
+        unsigned count = payload[14];
+        unsigned first = payload[15];
+        unsigned n = (length - telemetrySTATS_HEADER) / telemetrySTATS_RECORD;
+        unsigned i;
+
+        for (i = 0; i < n && first + i < MAX_TASKS; i++) {
+            const unsigned char *p = payload + telemetrySTATS_HEADER + i * telemetrySTATS_RECORD;
+            Record *r = &records[first + i];
+            r->number = p[0];
+            r->state = p[1];
+            r->priority = p[2];
+            r->watermark = (unsigned)get_le(p + 3, 2);
+            r->delta = get_le(p + 5, 4);
+        }
+
+        /* The last frame of a set completes the table */
+        if (first + n >= count) {
+            print_table(get_le(payload, 4), get_le(payload + 4, 4), get_le(payload + 8, 4),
+                        (unsigned)get_le(payload + 12, 2), count);
+        }
+    }
+}
+
+static void parse_byte(Parser *parser, unsigned char c)
+{
+    switch (parser->state) {
+    case WAIT_SYNC:
+        if (c == telemetrySYNC) {
+            parser->frame[0] = c;
+            parser->length = 1;
+            parser->state = WAIT_LENGTH;
+        } else if (c == '\n' || c == '\r' || c == '\t' || (c >= ' ' && c < 0x7F)) {
+            fputc(c, stderr);
+        }
+        break;
+
+    case WAIT_LENGTH:
+        if (c > telemetryMAX_PAYLOAD) {
+            parser->state = WAIT_SYNC;
+            break;
+        }
+        parser->frame[parser->length++] = c;
+        parser->expected = c + telemetryOVERHEAD;
+        parser->state = WAIT_BODY;
+        break;
+
+    case WAIT_BODY:
+        parser->frame[parser->length++] = c;
+        if (parser->length == parser->expected) {
+            size_t covered = parser->length - 3; /* length, type and payload */
+            unsigned crc = (unsigned)get_le(parser->frame + parser->length - 2, 2);
+
+            if (usTelemetryCrc16(parser->frame + 1, covered, 0xFFFF) == crc) {
+                handle_frame(parser->frame);
+            } else {
+                crc_errors++;
+            }
+            parser->state = WAIT_SYNC;
+        }
+        break;
+    }
+}
+
+static speed_t baud_constant(long baud)
+{
+    switch (baud) {
+    case 9600: return B9600;
+    case 19200: return B19200;
+    case 38400: return B38400;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    default: return 0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    Parser parser = { WAIT_SYNC, { 0 }, 0, 0 };
+    unsigned char buffer[256];
+    long baud = 19200;
+    int fd = STDIN_FILENO;
+    ssize_t n, i;
+
+    if (argc > 3 || (argc > 1 && strcmp(argv[1], "-h") == 0)) {
+        fprintf(stderr, "usage: %s [device [baud]]\n", argv[0]);
+        return 2;
+    }
+    if (argc > 2) {
+        baud = strtol(argv[2], NULL, 10);
+    }
+    if (argc > 1) {
+        fd = open(argv[1], O_RDONLY | O_NOCTTY);
+        if (fd < 0) {
+            perror(argv[1]);
+            return 1;
+        }
+    }
+
+    /* A serial device is switched to raw mode at the baud rate of the board */
+    if (isatty(fd)) {
+        struct termios tio;
+        speed_t speed = baud_constant(baud);
+
+        if (speed == 0 || tcgetattr(fd, &tio) != 0) {
+            fprintf(stderr, "cannot configure the device at %ld baud\n", baud);
+            return 1;
+        }
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, speed);
+        cfsetospeed(&tio, speed);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+
+    while ((n = read(fd, buffer, sizeof(buffer))) > 0) {
+        for (i = 0; i < n; i++) {
+            parse_byte(&parser, buffer[i]);
+        }
+    }
+
+    return 0;
+}
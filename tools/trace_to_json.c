@@ -0,0 +1,317 @@
+/*
+ * trace_to_json.c
+ *
+ * Host converter of the trace recorder dumps of the cortex_LM3S811 program.
+ * Reads the UART output from a serial device or from standard input, waits
+ * for the frames sent by the "trace" command and writes the events in the
+ * Chrome trace JSON format, which chrome://tracing and ui.perfetto.dev open.
+ *
+ *   make tools/trace_to_json
+ *   tools/trace_to_json /dev/ttyUSB0 > trace.json     (then type "trace")
+ *   tools/trace_to_json < capture.bin > trace.json
+ *
+ * Every task gets a row with a slice for each time it ran and marks for the
+ * queue, stream buffer and notification events it caused.  Events recorded
+ * in interrupts go to an "ISR" row.  The converter stops after the first
+ * complete dump.  Text sent on the same UART is passed through to standard
+ * error.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+
+#include "telemetry.h"
+#include "recorder.h"
+
+#define MAX_TASKS 256
+#define ISR_ROW   1000 /* tid of the interrupt row, away from the task numbers */
+
+typedef enum { WAIT_SYNC, WAIT_LENGTH, WAIT_BODY } ParserState;
+
+typedef struct {
+    ParserState state;
+    unsigned char frame[telemetryMAX_PAYLOAD + telemetryOVERHEAD];
+    size_t length; /* bytes of the frame received so far, sync included */
+    size_t expected;
+} Parser;
+
+static char names[MAX_TASKS][32];
+static unsigned long crc_errors;
+static double unit_us = 0.8;      /* microseconds per timestamp unit, from the information frame */
+static int have_time;
+static unsigned last_low;         /* low 16 bits of the previous record */
+static long long now;             /* rebuilt time of the previous record, in units */
+static int running = -1;          /* task of the open slice, -1 before the first switch */
+static long long running_since;
+static int events;                /* events written, for the separators */
+static int done;
+
+static unsigned long get_le(const unsigned char *p, int bytes)
+{
+    unsigned long value = 0;
+    while (bytes-- > 0) {
+        value = (value << 8) | p[bytes];
+    }
+    return value;
+}
+
+static const char *event_name(unsigned event)
+{
+    static const char *const names[] = {
+        "sync", "switched in", "ready", "delay",
+        "queue send", "queue send", "queue receive", "queue receive",
+        "queue blocked on send", "queue blocked on receive",
+        "stream send", "stream send", "stream receive", "stream receive",
+        "stream blocked on send", "stream blocked on receive",
+        "notify take blocked", "notify give", "notify"
+    };
+    return (event < sizeof(names) / sizeof(names[0])) ? names[event] : "unknown";
+}
+
+static int from_isr(unsigned event)
+{
+    return event == eRecorderQueueSendFromISR || event == eRecorderQueueReceiveFromISR ||
+           event == eRecorderStreamSendFromISR || event == eRecorderStreamReceiveFromISR ||
+           event == eRecorderNotifyGiveFromISR;
+}
+
+static void begin_event(void)
+{
+    printf("%s\n  ", events++ ? "," : "");
+}
+
+static void emit_slice(int task, long long start, long long end)
+{
+    begin_event();
+    printf("{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+           names[task][0] ? names[task] : "?", task, start * unit_us, (end - start) * unit_us);
+}
+
+static void emit_instant(int tid, const char *name, const char *scope, unsigned object, long long time)
+{
+    begin_event();
+    printf("{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"%s\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"args\":{\"object\":%u}}",
+           name, scope, tid, time * unit_us, object);
+}
+
+static void handle_record(unsigned long record)
+{
+    unsigned low = record & 0xFFFF;
+    unsigned event = (record >> 16) & 0xFF;
+    unsigned object = (record >> 24) & 0xFF;
+
+    /* Records are never further apart than half the range of the timestamp, see recorder.h */
+    if (have_time) {
+        now += (short)(unsigned short)(low - last_low);
+    } else {
+        now = 0;
+        have_time = 1;
+    }
+    last_low = low;
+
+    switch (event) {
+    case eRecorderSync:
+        break;
+
+    case eRecorderSwitchedIn:
+        if (running >= 0 && (int)object != running) {
+            emit_slice(running, running_since, now);
+        }
+        if ((int)object != running) {
+            running = (int)object;
+            running_since = now;
+        }
+        break;
+
+    case eRecorderTaskReady:
+    case eRecorderNotify:
+    case eRecorderNotifyGiveFromISR:
+        /* The object is the task made ready or notified, shown on its own row */
+        emit_instant((int)object, event_name(event), "t", object, now);
+        break;
+
+    default:
+        emit_instant(from_isr(event) ? ISR_ROW : (running >= 0 ? running : ISR_ROW),
+                     event_name(event), "t", object, now);
+        break;
+    }
+}
+
+static void finish(void)
+{
+    int i;
+
+    if (running >= 0) {
+        emit_slice(running, running_since, now);
+    }
+    for (i = 0; i < MAX_TASKS; i++) {
+        if (names[i][0]) {
+            begin_event();
+            printf("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", i, names[i]);
+        }
+    }
+    begin_event();
+    printf("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"ISR\"}}", ISR_ROW);
+    printf("\n]}\n");
+    if (crc_errors > 0) {
+        fprintf(stderr, "Frames dropped: %lu\n", crc_errors);
+    }
+    fflush(stdout);
+}
+
+static void handle_frame(const unsigned char *frame)
+{
+    unsigned length = frame[1];
+    unsigned type = frame[2];
+    const unsigned char *payload = frame + 3;
+
+    if (type == telemetryTYPE_TRACE_INFO && length >= 5) {
+        unsigned long clock = get_le(payload, 4);
+        if (clock != 0) {
+            unit_us = (double)(1UL << payload[4]) * 1e6 / (double)clock;
+        }
+    } else if (type == telemetryTYPE_NAME && length >= 1) {
+        size_t name_length = length - 1;
+        size_t i;
+        if (name_length >= sizeof(names[0])) {
+            name_length = sizeof(names[0]) - 1;
+        }
+        /* Quotes and backslashes would break the JSON */
+        for (i = 0; i < name_length; i++) {
+            unsigned char c = payload[1 + i];
+            names[payload[0]][i] = (c == '"' || c == '\\' || c < ' ') ? '_' : (char)c;
+        }
+        names[payload[0]][name_length] = '\0';
+    } else if (type == telemetryTYPE_TRACE && length >= telemetryTRACE_HEADER) {
+        unsigned long lost = get_le(payload, 4);
+        unsigned n = (length - telemetryTRACE_HEADER) / 4;
+        unsigned i;
+
+        if (lost > 0) {
+            begin_event();
+            printf("{\"name\":\"%lu records lost\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}",
+                   lost, ISR_ROW, now * unit_us);
+        }
+        for (i = 0; i < n; i++) {
+            handle_record(get_le(payload + telemetryTRACE_HEADER + i * 4, 4));
+        }
+
+        /* A trace frame without records ends the dump */
+        if (n == 0) {
+            finish();
+            done = 1;
+        }
+    }
+}
+
+static void parse_byte(Parser *parser, unsigned char c)
+{
+    switch (parser->state) {
+    case WAIT_SYNC:
+        if (c == telemetrySYNC) {
+            parser->frame[0] = c;
+            parser->length = 1;
+            parser->state = WAIT_LENGTH;
+        } else if (c == '\n' || c == '\r' || c == '\t' || (c >= ' ' && c < 0x7F)) {
+            fputc(c, stderr);
+        }
+        break;
+
+    case WAIT_LENGTH:
+        if (c > telemetryMAX_PAYLOAD) {
+            parser->state = WAIT_SYNC;
+            break;
+        }
+        parser->frame[parser->length++] = c;
+        parser->expected = c + telemetryOVERHEAD;
+        parser->state = WAIT_BODY;
+        break;
+
+    case WAIT_BODY:
+        parser->frame[parser->length++] = c;
+        if (parser->length == parser->expected) {
+            size_t covered = parser->length - 3; /* length, type and payload */
+            unsigned crc = (unsigned)get_le(parser->frame + parser->length - 2, 2);
+
+            if (usTelemetryCrc16(parser->frame + 1, covered, 0xFFFF) == crc) {
+                handle_frame(parser->frame);
+            } else {
+                crc_errors++;
+            }
+            parser->state = WAIT_SYNC;
+        }
+        break;
+    }
+}
+
+static speed_t baud_constant(long baud)
+{
+    switch (baud) {
+    case 9600: return B9600;
+    case 19200: return B19200;
+    case 38400: return B38400;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    default: return 0;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    Parser parser = { WAIT_SYNC, { 0 }, 0, 0 };
+    unsigned char buffer[256];
+    long baud = 19200;
+    int fd = STDIN_FILENO;
+    ssize_t n, i;
+
+    if (argc > 3 || (argc > 1 && strcmp(argv[1], "-h") == 0)) {
+        fprintf(stderr, "usage: %s [device [baud]]\n", argv[0]);
+        return 2;
+    }
+    if (argc > 2) {
+        baud = strtol(argv[2], NULL, 10);
+    }
+    if (argc > 1) {
+        fd = open(argv[1], O_RDONLY | O_NOCTTY);
+        if (fd < 0) {
+            perror(argv[1]);
+            return 1;
+        }
+    }
+
+    /* A serial device is switched to raw mode at the baud rate of the board */
+    if (isatty(fd)) {
+        struct termios tio;
+        speed_t speed = baud_constant(baud);
+
+        if (speed == 0 || tcgetattr(fd, &tio) != 0) {
+            fprintf(stderr, "cannot configure the device at %ld baud\n", baud);
+            return 1;
+        }
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, speed);
+        cfsetospeed(&tio, speed);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+
+    printf("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    while (!done && (n = read(fd, buffer, sizeof(buffer))) > 0) {
+        for (i = 0; i < n && !done; i++) {
+            parse_byte(&parser, buffer[i]);
+        }
+    }
+
+    if (!done) {
+        fprintf(stderr, "incomplete dump\n");
+        finish();
+        return 1;
+    }
+    return 0;
+}
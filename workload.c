@@ -0,0 +1,132 @@
+/*
+ * workload.c
+ *
+ * Synthetic sensor workload generator for the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#include "workload.h"
+
+#define workloadMAX_VALUE 100 // Values go from 0 to workloadMAX_VALUE - 1
+
+/* One period of a sine between 0 and 99. */
+static const uint8_t pucSine[workloadSINE_STEPS] = {
+    50, 54, 59, 64, 68, 73, 77, 81, 85, 88, 91, 93, 95, 97, 98, 99,
+    99, 99, 98, 97, 95, 93, 91, 88, 85, 81, 77, 73, 68, 64, 59, 54,
+    50, 45, 40, 35, 31, 26, 22, 18, 14, 11,  8,  6,  4,  2,  1,  0,
+     0,  0,  1,  2,  4,  6,  8, 11, 14, 18, 22, 26, 31, 35, 40, 45
+};
+
+/*-----------------------------------------------------------*/
+
+static int32_t prvSensorSample(Workload_t *pxWorkload, UBaseType_t uxSensor)
+{
+    uint8_t ucPhase = pxWorkload->pucPhase[uxSensor];
+
+    switch (pxWorkload->eShape)
+    {
+        case eWaveRamp:
+            pxWorkload->pucPhase[uxSensor] = (ucPhase + 1) % workloadMAX_VALUE;
+            return ucPhase;
+
+        case eWaveSine:
+            pxWorkload->pucPhase[uxSensor] = (ucPhase + 1) % workloadSINE_STEPS;
+            return pucSine[ucPhase];
+
+        case eWaveNoise:
+        default:
+            return (int32_t)ulPrngRange(&pxWorkload->xPrng, workloadMAX_VALUE);
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+void vWorkloadInit(Workload_t *pxWorkload, UBaseType_t uxSensors, WaveShape_t eShape, uint32_t ulPeriod, uint32_t ulSeed)
+{
+    UBaseType_t x;
+    uint32_t ulSpan = (eShape == eWaveSine) ? workloadSINE_STEPS : workloadMAX_VALUE;
+
+    if (uxSensors < 1)
+    {
+        uxSensors = 1;
+    }
+    if (uxSensors > workloadMAX_SENSORS)
+    {
+        uxSensors = workloadMAX_SENSORS;
+    }
+
+    pxWorkload->eShape = eShape;
+    pxWorkload->uxSensors = uxSensors;
+    for (x = 0; x < workloadMAX_SENSORS; x++)
+    {
+        // Spread the sensors over a period so they do not produce the same values
+        pxWorkload->pucPhase[x] = (uint8_t)((x * ulSpan) / uxSensors);
+    }
+    pxWorkload->usBurstPeriod = 0;
+    pxWorkload->usBurstLength = 1;
+    pxWorkload->usTick = 0;
+    pxWorkload->ucJitterPercent = 0;
+    pxWorkload->ulPeriod = ulPeriod;
+    vPrngSeed(&pxWorkload->xPrng, ulSeed);
+    pxWorkload->ulGenerated = 0;
+    pxWorkload->ulDropped = 0;
+}
+
+void vWorkloadSetBurst(Workload_t *pxWorkload, uint16_t usPeriod, uint16_t usLength)
+{
+    uint16_t usMaxLength = workloadMAX_SAMPLES_PER_TICK / pxWorkload->uxSensors;
+
+    pxWorkload->usBurstPeriod = usPeriod;
+    pxWorkload->usBurstLength = (usLength < 1) ? 1 : (usLength > usMaxLength) ? usMaxLength : usLength;
+    pxWorkload->usTick = 0;
+}
+
+void vWorkloadSetJitter(Workload_t *pxWorkload, uint8_t ucPercent)
+{
+    pxWorkload->ucJitterPercent = (ucPercent > workloadMAX_JITTER_PERCENT) ? workloadMAX_JITTER_PERCENT : ucPercent;
+}
+
+UBaseType_t uxWorkloadTick(Workload_t *pxWorkload, int32_t *plSamples)
+{
+    UBaseType_t uxPerSensor = 1;
+    UBaseType_t uxCount = 0;
+    UBaseType_t x, i;
+
+    if (pxWorkload->usBurstPeriod > 0)
+    {
+        if (++pxWorkload->usTick >= pxWorkload->usBurstPeriod)
+        {
+            pxWorkload->usTick = 0;
+            uxPerSensor = pxWorkload->usBurstLength;
+        }
+    }
+
+    // Sensors are interleaved, as if they were sampled one after the other
+    for (i = 0; i < uxPerSensor; i++)
+    {
+        for (x = 0; x < pxWorkload->uxSensors; x++)
+        {
+            plSamples[uxCount++] = prvSensorSample(pxWorkload, x);
+        }
+    }
+
+    pxWorkload->ulGenerated += uxCount;
+
+    return uxCount;
+}
+
+uint32_t ulWorkloadNextPeriod(Workload_t *pxWorkload)
+{
+    uint32_t ulSpread;
+
+    if (pxWorkload->ucJitterPercent == 0)
+    {
+        return pxWorkload->ulPeriod;
+    }
+
+    // Uniform deviation in [-spread, +spread]
+    ulSpread = (pxWorkload->ulPeriod / 100) * pxWorkload->ucJitterPercent;
+    return pxWorkload->ulPeriod - ulSpread + ulPrngRange(&pxWorkload->xPrng, 2 * ulSpread + 1);
+}
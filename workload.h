@@ -0,0 +1,98 @@
+/*
+ * workload.h
+ *
+ * Synthetic sensor workload generator for the cortex_LM3S811 program.
+ *
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ */
+
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include "FreeRTOS.h"
+#include "prng.h"
+
+/* Configuration of the workload generator. */
+#define workloadMAX_SENSORS          4  // Max number of virtual sensors
+#define workloadMAX_SAMPLES_PER_TICK 16 // Max samples produced by a single timer interrupt, sensors times burst length
+#define workloadSINE_STEPS           64 // Samples per period of the sine waveform
+#define workloadMAX_JITTER_PERCENT   50 // Max deviation of a timer period from the nominal one
+
+/**
+ * @brief Shape of the values produced by the virtual sensors, identified by a letter.
+ */
+typedef enum {
+    eWaveNoise = 'n', /**< Uniform random values */
+    eWaveRamp = 'r',  /**< Saw tooth that climbs one degree per sample */
+    eWaveSine = 's'   /**< Sine read from a table, workloadSINE_STEPS samples per period */
+} WaveShape_t;
+
+/**
+ * @brief State of the generator, advanced once per timer interrupt.
+ *
+ * Every virtual sensor produces one sample per tick, or a burst of samples
+ * every usBurstPeriod ticks.  All values are between 0 and 99 like the
+ * simulated temperatures.
+ */
+typedef struct {
+    WaveShape_t eShape;                       /**< Waveform of every sensor */
+    UBaseType_t uxSensors;                    /**< Number of virtual sensors */
+    uint8_t pucPhase[workloadMAX_SENSORS];    /**< Position of each sensor in its waveform */
+    uint16_t usBurstPeriod;                   /**< Ticks between bursts, 0 disables them */
+    uint16_t usBurstLength;                   /**< Samples per sensor in a burst tick */
+    uint16_t usTick;                          /**< Ticks since the last burst */
+    uint8_t ucJitterPercent;                  /**< Max deviation of each timer period from ulPeriod */
+    uint32_t ulPeriod;                        /**< Nominal timer period, in timer clock cycles */
+    Prng_t xPrng;                             /**< Source of the noise and of the jitter */
+    volatile uint32_t ulGenerated;            /**< Samples produced since initialisation */
+    volatile uint32_t ulDropped;              /**< Samples lost because the pipeline was full */
+} Workload_t;
+
+/**
+ * @brief Initialises the generator without bursts nor jitter.
+ *
+ * @param pxWorkload Generator to initialise.
+ * @param uxSensors Number of virtual sensors, clamped to workloadMAX_SENSORS.
+ * @param eShape Waveform of the sensors, their phases are spread over a period.
+ * @param ulPeriod Nominal timer period, in timer clock cycles.
+ * @param ulSeed Seed of the noise and jitter, the same seed gives the same workload.
+ */
+void vWorkloadInit(Workload_t *pxWorkload, UBaseType_t uxSensors, WaveShape_t eShape, uint32_t ulPeriod, uint32_t ulSeed);
+
+/**
+ * @brief Sets the burst profile of the generator.
+ *
+ * @param pxWorkload Generator to update.
+ * @param usPeriod Ticks between bursts, 0 disables them.
+ * @param usLength Samples per sensor in a burst tick, clamped so a tick
+ *        never exceeds workloadMAX_SAMPLES_PER_TICK samples.
+ */
+void vWorkloadSetBurst(Workload_t *pxWorkload, uint16_t usPeriod, uint16_t usLength);
+
+/**
+ * @brief Sets the random deviation of every timer period.
+ *
+ * @param pxWorkload Generator to update.
+ * @param ucPercent Max deviation from the nominal period, clamped to workloadMAX_JITTER_PERCENT.
+ */
+void vWorkloadSetJitter(Workload_t *pxWorkload, uint8_t ucPercent);
+
+/**
+ * @brief Produces the samples of one timer tick.
+ *
+ * @param pxWorkload Generator to advance.
+ * @param plSamples Receives the samples, room for workloadMAX_SAMPLES_PER_TICK values.
+ * @return UBaseType_t Number of samples written.
+ */
+UBaseType_t uxWorkloadTick(Workload_t *pxWorkload, int32_t *plSamples);
+
+/**
+ * @brief Returns the length of the next timer period, with the jitter applied.
+ *
+ * @param pxWorkload Generator to advance.
+ * @return uint32_t Period in timer clock cycles.
+ */
+uint32_t ulWorkloadNextPeriod(Workload_t *pxWorkload);
+
+#endif /* WORKLOAD_H */